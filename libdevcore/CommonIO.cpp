@@ -68,6 +68,37 @@ string dev::readFileAsString(string const& _file)
 	return readFile<string>(_file);
 }
 
+bool dev::writeFileAtomically(string const& _file, string const& _data)
+{
+	namespace fs = boost::filesystem;
+	fs::path path(_file);
+	boost::system::error_code error;
+	if (path.has_parent_path())
+	{
+		fs::create_directories(path.parent_path(), error);
+		if (error)
+			return false;
+	}
+
+	fs::path temporary = path.parent_path() / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	{
+		ofstream file(temporary.string(), ios::binary);
+		file << _data;
+		if (!file)
+		{
+			fs::remove(temporary, error);
+			return false;
+		}
+	}
+	fs::rename(temporary, path, error);
+	if (error)
+	{
+		fs::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
+
 string dev::readStandardInput()
 {
 	string ret;
@@ -35,6 +35,12 @@ namespace dev
 /// If the file doesn't exist or isn't readable, returns an empty container / bytes.
 std::string readFileAsString(std::string const& _file);
 
+/// Writes @a _data to the file @a _file and creates its directory if necessary.
+/// The data is written to a temporary file that is then moved into place, so that
+/// concurrent readers never see a partially written file.
+/// @returns false if the file could not be written.
+bool writeFileAtomically(std::string const& _file, std::string const& _data);
+
 /// Retrieve and returns the contents of standard input (until EOF).
 std::string readStandardInput();
 
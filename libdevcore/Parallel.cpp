@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helpers to distribute independent work items over several threads.
+ */
+
+#include <libdevcore/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace std;
+using namespace dev;
+
+void dev::parallelFor(size_t _count, unsigned _threads, function<void(size_t)> const& _task)
+{
+	// The shared pool is only created if there is parallel work.
+	ThreadPool* pool = _threads > 1 && _count > 1 ? &ThreadPool::shared() : nullptr;
+	if (!pool || pool->threads() == 0)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+	size_t helpers = min<size_t>({_threads - 1u, _count - 1, pool->threads()});
+
+	// Helpers are queued in the shared pool and can start after this function has returned,
+	// for example when the pool is busy with other work. The state is therefore shared, and
+	// a helper only touches the task after it has registered itself as active.
+	struct State
+	{
+		explicit State(size_t _count): firstFailure(_count), exceptions(_count) {}
+		atomic<size_t> nextIndex{0};
+		// Smallest index of a failed task, _count if none failed so far.
+		atomic<size_t> firstFailure;
+		vector<exception_ptr> exceptions;
+		mutex activeMutex;
+		condition_variable helperFinished;
+		size_t activeHelpers = 0;
+		bool closed = false;
+	};
+	auto state = make_shared<State>(_count);
+
+	auto runTasks = [&_task, _count](State& _state)
+	{
+		for (
+			size_t index = _state.nextIndex++;
+			index < _count && index < _state.firstFailure;
+			index = _state.nextIndex++
+		)
+			try
+			{
+				_task(index);
+			}
+			catch (...)
+			{
+				_state.exceptions[index] = current_exception();
+				size_t failure = _state.firstFailure;
+				while (index < failure)
+					if (_state.firstFailure.compare_exchange_weak(failure, index))
+						break;
+			}
+	};
+	auto helper = [state, runTasks]()
+	{
+		{
+			lock_guard<mutex> lock(state->activeMutex);
+			if (state->closed)
+				return;
+			++state->activeHelpers;
+		}
+		runTasks(*state);
+		{
+			lock_guard<mutex> lock(state->activeMutex);
+			--state->activeHelpers;
+		}
+		state->helperFinished.notify_all();
+	};
+
+	exception_ptr queueFailure;
+	try
+	{
+		for (size_t i = 0; i < helpers; ++i)
+			pool->addTask(helper);
+	}
+	catch (...)
+	{
+		queueFailure = current_exception();
+	}
+	if (!queueFailure)
+		runTasks(*state);
+	{
+		unique_lock<mutex> lock(state->activeMutex);
+		state->closed = true;
+		state->helperFinished.wait(lock, [&]() { return state->activeHelpers == 0; });
+	}
+	if (queueFailure)
+		rethrow_exception(queueFailure);
+
+	for (exception_ptr const& exception: state->exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
+
+ThreadPool::ThreadPool(unsigned _threads)
+{
+	if (_threads > 1)
+		try
+		{
+			for (unsigned i = 0; i < _threads; ++i)
+				m_threads.emplace_back([this]() { work(); });
+		}
+		catch (...)
+		{
+			// Joinable threads must not be destroyed.
+			stop();
+			throw;
+		}
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool(max(thread::hardware_concurrency(), 2u));
+	return pool;
+}
+
+future<void> ThreadPool::addTask(function<void()> _task)
+{
+	packaged_task<void()> task(move(_task));
+	future<void> result = task.get_future();
+	if (m_threads.empty())
+		task();
+	else
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_tasks.emplace_back(move(task));
+		}
+		m_taskAdded.notify_one();
+	}
+	return result;
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		packaged_task<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_taskAdded.wait(lock, [&]() { return m_stopping || !m_tasks.empty(); });
+			// Queued tasks are still run, so that nobody waits for a future that is never set.
+			if (m_tasks.empty())
+				return;
+			task = move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		// Exceptions are stored in the future of the task.
+		task();
+	}
+}
+
+void ThreadPool::stop()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAdded.notify_all();
+	for (thread& t: m_threads)
+		t.join();
+	m_threads.clear();
+}
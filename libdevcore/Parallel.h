@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helpers to distribute independent work items over several threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/// Calls @a _task for every index in [0, @a _count) using at most @a _threads threads,
+/// one of which is the calling thread. The other threads are taken from ThreadPool::shared(),
+/// so nested calls do not start new threads and the total number of threads is bounded by
+/// the size of that pool. Returns after all started tasks have finished.
+/// Indices are handed out in increasing order. If tasks throw, no task with an index larger
+/// than that of a failed task is started and the exception of the failed task with the
+/// smallest index is rethrown, i.e. the observable behaviour is that of a serial loop.
+/// With @a _threads <= 1 the tasks are run serially on the calling thread.
+void parallelFor(size_t _count, unsigned _threads, std::function<void(size_t)> const& _task);
+
+/**
+ * Fixed set of threads that run tasks in the order in which they were added.
+ * In contrast to parallelFor, the number of tasks does not have to be known in advance.
+ * The destructor waits until all tasks that were added have finished.
+ */
+class ThreadPool
+{
+public:
+	/// Starts @a _threads threads. With @a _threads <= 1, no threads are started and
+	/// every task is run by addTask before it returns.
+	explicit ThreadPool(unsigned _threads);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// @returns the pool that is shared by all parallel work of the compiler. It is created on
+	/// first use with as many threads as the hardware supports, but at least two.
+	static ThreadPool& shared();
+
+	/// @returns the number of threads of the pool, zero if tasks are run by addTask.
+	unsigned threads() const { return unsigned(m_threads.size()); }
+
+	/// Adds @a _task to the queue.
+	/// The result must not be waited for on a thread of the pool, because that thread
+	/// might be needed to run the task.
+	/// @returns a future that is ready once the task has finished and that rethrows the
+	/// exception thrown by the task, if any.
+	std::future<void> addTask(std::function<void()> _task);
+
+private:
+	void work();
+	/// Makes the threads finish the queued tasks and exit, and waits for them.
+	void stop();
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskAdded;
+	std::deque<std::packaged_task<void()>> m_tasks;
+	bool m_stopping = false;
+	std::vector<std::thread> m_threads;
+};
+
+}
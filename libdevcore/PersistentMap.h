@@ -0,0 +1,337 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Ordered map whose copies share their structure.
+ */
+
+#pragma once
+
+#include <boost/functional/hash.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Ordered map with value semantics where copying takes constant time.
+ *
+ * The entries are stored in a treap whose nodes are shared between copies. Modifications
+ * copy the nodes on the path to the modified entry unless they are only referenced by the
+ * modified map, in which case they are changed in place. The priority of a node is derived
+ * from the hash of its key, so maps with the same keys have the same shape. This allows
+ * comparisons and intersections to skip subtrees that are shared by both maps.
+ *
+ * Iterators are invalidated by any modification of the map.
+ */
+template <class Key, class Value>
+class PersistentMap
+{
+	struct Node;
+	using NodePtr = std::shared_ptr<Node>;
+
+public:
+	using value_type = std::pair<Key, Value>;
+
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = PersistentMap::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = value_type const*;
+		using reference = value_type const&;
+
+		const_iterator() = default;
+
+		reference operator*() const { return m_path.back()->entry; }
+		pointer operator->() const { return &m_path.back()->entry; }
+		const_iterator& operator++()
+		{
+			Node const* node = m_path.back();
+			m_path.pop_back();
+			descendLeft(node->right.get());
+			return *this;
+		}
+		const_iterator operator++(int) { const_iterator ret = *this; ++*this; return ret; }
+		bool operator==(const_iterator const& _other) const
+		{
+			return m_path.empty() ? _other.m_path.empty() : !_other.m_path.empty() && m_path.back() == _other.m_path.back();
+		}
+		bool operator!=(const_iterator const& _other) const { return !(*this == _other); }
+
+	private:
+		friend class PersistentMap;
+		explicit const_iterator(Node const* _root) { descendLeft(_root); }
+		void descendLeft(Node const* _node)
+		{
+			for (; _node; _node = _node->left.get())
+				m_path.push_back(_node);
+		}
+
+		/// Nodes whose entry and right subtree are not visited yet, the current node is the last one.
+		std::vector<Node const*> m_path;
+	};
+
+	bool empty() const { return !m_root; }
+	void clear() { m_root.reset(); }
+
+	const_iterator begin() const { return const_iterator(m_root.get()); }
+	const_iterator end() const { return const_iterator(); }
+
+	/// @returns a pointer to the value stored under @a _key or nullptr if there is none.
+	Value const* find(Key const& _key) const
+	{
+		for (Node const* node = m_root.get(); node;)
+			if (_key < node->entry.first)
+				node = node->left.get();
+			else if (node->entry.first < _key)
+				node = node->right.get();
+			else
+				return &node->entry.second;
+		return nullptr;
+	}
+	size_t count(Key const& _key) const { return find(_key) ? 1 : 0; }
+	Value const& at(Key const& _key) const
+	{
+		if (Value const* value = find(_key))
+			return *value;
+		throw std::out_of_range("PersistentMap::at");
+	}
+
+	/// Stores @a _value under @a _key, replacing any previous value.
+	void set(Key const& _key, Value _value)
+	{
+		Value const* current = find(_key);
+		if (!current || !(*current == _value))
+			insert(m_root, _key, std::move(_value), priority(_key));
+	}
+	/// Removes the entry with key @a _key.
+	/// @returns true if there was such an entry.
+	bool erase(Key const& _key)
+	{
+		return find(_key) && erase(m_root, _key);
+	}
+	/// Removes all entries whose key is larger than @a _key.
+	void eraseAbove(Key const& _key)
+	{
+		Node const* last = m_root.get();
+		while (last && last->right)
+			last = last->right.get();
+		if (!last || !(_key < last->entry.first))
+			return;
+		NodePtr less;
+		NodePtr equal;
+		NodePtr greater;
+		split(std::move(m_root), _key, less, equal, greater);
+		if (equal)
+		{
+			Node& node = own(equal);
+			node.left.reset();
+			node.right.reset();
+		}
+		m_root = merge(std::move(less), std::move(equal));
+	}
+	/// Removes all entries that are not present with an equal value in @a _other.
+	void intersect(PersistentMap const& _other)
+	{
+		m_root = intersection(std::move(m_root), _other.m_root);
+	}
+
+	bool operator==(PersistentMap const& _other) const { return equalTrees(m_root.get(), _other.m_root.get()); }
+	bool operator!=(PersistentMap const& _other) const { return !(*this == _other); }
+
+private:
+	struct Node
+	{
+		value_type entry;
+		uint64_t priority;
+		NodePtr left;
+		NodePtr right;
+	};
+
+	static uint64_t priority(Key const& _key)
+	{
+		// The hash of small integers is often the integer itself, so it is mixed to keep
+		// the tree balanced for consecutive keys.
+		uint64_t x = boost::hash<Key>()(_key);
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9u;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebu;
+		return x ^ (x >> 31);
+	}
+	/// @returns true if @a _a has to be an ancestor of @a _b. Ties are broken by the key,
+	/// so that the shape of the tree only depends on its keys.
+	static bool higher(Node const& _a, Node const& _b)
+	{
+		if (_a.priority != _b.priority)
+			return _a.priority > _b.priority;
+		return _a.entry.first < _b.entry.first;
+	}
+	/// Replaces @a _node by a copy unless it is its only reference.
+	/// @returns the node, which can be modified.
+	static Node& own(NodePtr& _node)
+	{
+		if (_node.use_count() != 1)
+			_node = std::make_shared<Node>(*_node);
+		return *_node;
+	}
+
+	static void insert(NodePtr& _node, Key const& _key, Value&& _value, uint64_t _priority)
+	{
+		if (!_node)
+		{
+			_node = std::make_shared<Node>(Node{value_type(_key, std::move(_value)), _priority, nullptr, nullptr});
+			return;
+		}
+		Node& node = own(_node);
+		if (_key < node.entry.first)
+		{
+			insert(node.left, _key, std::move(_value), _priority);
+			if (higher(*node.left, node))
+			{
+				NodePtr left = std::move(node.left);
+				node.left = std::move(left->right);
+				left->right = std::move(_node);
+				_node = std::move(left);
+			}
+		}
+		else if (node.entry.first < _key)
+		{
+			insert(node.right, _key, std::move(_value), _priority);
+			if (higher(*node.right, node))
+			{
+				NodePtr right = std::move(node.right);
+				node.right = std::move(right->left);
+				right->left = std::move(_node);
+				_node = std::move(right);
+			}
+		}
+		else
+			node.entry.second = std::move(_value);
+	}
+
+	static bool erase(NodePtr& _node, Key const& _key)
+	{
+		if (!_node)
+			return false;
+		Node& node = own(_node);
+		if (_key < node.entry.first)
+			return erase(node.left, _key);
+		else if (node.entry.first < _key)
+			return erase(node.right, _key);
+		NodePtr left = std::move(node.left);
+		NodePtr right = std::move(node.right);
+		_node = merge(std::move(left), std::move(right));
+		return true;
+	}
+
+	/// @returns the union of two trees where all keys in @a _left are smaller than those in @a _right.
+	static NodePtr merge(NodePtr _left, NodePtr _right)
+	{
+		if (!_left)
+			return _right;
+		if (!_right)
+			return _left;
+		if (higher(*_left, *_right))
+		{
+			Node& left = own(_left);
+			left.right = merge(std::move(left.right), std::move(_right));
+			return _left;
+		}
+		else
+		{
+			Node& right = own(_right);
+			right.left = merge(std::move(_left), std::move(right.left));
+			return _right;
+		}
+	}
+
+	/// Splits @a _node into the entries with keys smaller than, equal to and larger than @a _key.
+	/// The subtrees of @a o_equal are not modified and still refer to other entries.
+	static void split(NodePtr _node, Key const& _key, NodePtr& o_less, NodePtr& o_equal, NodePtr& o_greater)
+	{
+		if (!_node)
+		{
+			o_less = o_equal = o_greater = nullptr;
+			return;
+		}
+		if (_key < _node->entry.first)
+		{
+			Node& node = own(_node);
+			split(std::move(node.left), _key, o_less, o_equal, node.left);
+			o_greater = std::move(_node);
+		}
+		else if (_node->entry.first < _key)
+		{
+			Node& node = own(_node);
+			split(std::move(node.right), _key, node.right, o_equal, o_greater);
+			o_less = std::move(_node);
+		}
+		else
+		{
+			o_less = _node->left;
+			o_greater = _node->right;
+			o_equal = std::move(_node);
+		}
+	}
+
+	static NodePtr intersection(NodePtr _a, NodePtr _b)
+	{
+		if (!_a || !_b)
+			return nullptr;
+		if (_a == _b)
+			return _a;
+		if (higher(*_b, *_a))
+			std::swap(_a, _b);
+		NodePtr less;
+		NodePtr equal;
+		NodePtr greater;
+		split(std::move(_b), _a->entry.first, less, equal, greater);
+		NodePtr left = intersection(_a->left, std::move(less));
+		NodePtr right = intersection(_a->right, std::move(greater));
+		if (equal && equal->entry.second == _a->entry.second)
+		{
+			if (left != _a->left || right != _a->right)
+			{
+				Node& node = own(_a);
+				node.left = std::move(left);
+				node.right = std::move(right);
+			}
+			return _a;
+		}
+		return merge(std::move(left), std::move(right));
+	}
+
+	/// Relies on the shape of a tree only depending on its keys.
+	static bool equalTrees(Node const* _a, Node const* _b)
+	{
+		if (_a == _b)
+			return true;
+		if (!_a || !_b)
+			return false;
+		return _a->entry == _b->entry && equalTrees(_a->left.get(), _b->left.get()) && equalTrees(_a->right.get(), _b->right.get());
+	}
+
+	NodePtr m_root;
+};
+
+}
@@ -25,11 +25,215 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <boost/regex.hpp>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+namespace
+{
+
+struct Template;
+
+/// A piece of a parsed template.
+struct Part
+{
+	enum class Kind { Text, Parameter, List, Condition };
+	Kind kind;
+	/// The text to copy for Text parts, the name of the parameter otherwise.
+	string value;
+	/// Repeated part of a list, part for a true condition.
+	unique_ptr<Template> body;
+	/// Part for a false condition, can be null.
+	unique_ptr<Template> alternative;
+};
+
+struct Template
+{
+	/// Text of the template, only used for error messages.
+	string source;
+	vector<Part> parts;
+};
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the length of the parameter name followed by ">" that starts at @a _pos
+/// or zero if there is none.
+size_t parameterLength(string const& _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	if (end == _pos || end == _text.size() || _text[end] != '>')
+		return 0;
+	return end - _pos;
+}
+
+/// Parses @a _text into a sequence of parts. Mirrors the leftmost-first, non-greedy
+/// matching of the regular expression
+///     <(P)>|<#(P)>(.*?)</\2>|<\?(P)>(.*?)(<!\4>(.*?))?</\4>
+/// where P is [a-zA-Z0-9_$-]+, that was used in previous versions, i.e. list and
+/// condition parameters with the same name cannot be nested, and incomplete constructs
+/// are copied verbatim.
+unique_ptr<Template> parse(string _text)
+{
+	auto result = make_unique<Template>();
+	size_t textStart = 0;
+	auto addText = [&](size_t _end) {
+		if (_end > textStart)
+			result->parts.push_back(Part{Part::Kind::Text, _text.substr(textStart, _end - textStart), {}, {}});
+	};
+
+	for (size_t pos = 0; pos < _text.size(); ++pos)
+	{
+		if (_text[pos] != '<' || pos + 1 == _text.size())
+			continue;
+		char marker = _text[pos + 1];
+		if (size_t length = parameterLength(_text, pos + 1))
+		{
+			addText(pos);
+			result->parts.push_back(Part{Part::Kind::Parameter, _text.substr(pos + 1, length), {}, {}});
+			pos += length + 1;
+			textStart = pos + 1;
+		}
+		else if (marker == '#' || marker == '?')
+		{
+			size_t length = parameterLength(_text, pos + 2);
+			if (!length)
+				continue;
+			string name = _text.substr(pos + 2, length);
+			size_t bodyStart = pos + length + 3;
+			size_t close = _text.find("</" + name + ">", bodyStart);
+			if (close == string::npos)
+				continue;
+			addText(pos);
+			size_t bodyEnd = close;
+			unique_ptr<Template> alternative;
+			if (marker == '?')
+			{
+				size_t elseTag = _text.find("<!" + name + ">", bodyStart);
+				if (elseTag < close)
+				{
+					bodyEnd = elseTag;
+					size_t alternativeStart = elseTag + length + 3;
+					alternative = parse(_text.substr(alternativeStart, close - alternativeStart));
+				}
+			}
+			result->parts.push_back(Part{
+				marker == '#' ? Part::Kind::List : Part::Kind::Condition,
+				move(name),
+				parse(_text.substr(bodyStart, bodyEnd - bodyStart)),
+				move(alternative)
+			});
+			pos = close + length + 2;
+			textStart = pos + 1;
+		}
+	}
+	addText(_text.size());
+	result->source = move(_text);
+	return result;
+}
+
+/// @returns the parsed form of @a _text, which is cached for the lifetime of the process.
+shared_ptr<Template const> parsedTemplate(string const& _text)
+{
+	// The templates are almost always string literals, so the cache stays small.
+	// The limit protects against generated templates.
+	static size_t const maxCacheSize = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
+
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(_text);
+		if (it != cache.end())
+			return it->second;
+	}
+	shared_ptr<Template const> parsed = parse(_text);
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(_text, parsed);
+	return parsed;
+}
+
+struct Renderer
+{
+	Whiskers::StringMap const& parameters;
+	map<string, bool> const& conditions;
+	Whiskers::StringListMap const& listParameters;
+	string& output;
+
+	void render(Template const& _template, Whiskers::StringMap const* _listElement = nullptr)
+	{
+		for (Part const& part: _template.parts)
+			switch (part.kind)
+			{
+			case Part::Kind::Text:
+				output += part.value;
+				break;
+			case Part::Kind::Parameter:
+			{
+				auto it = _listElement ? _listElement->find(part.value) : parameters.end();
+				if (!_listElement || it == _listElement->end())
+				{
+					it = parameters.find(part.value);
+					assertThrow(
+						it != parameters.end(),
+						WhiskersError,
+						"Value for tag " + part.value + " not provided.\n" +
+						"Template:\n" +
+						_template.source
+					);
+				}
+				output += it->second;
+				break;
+			}
+			case Part::Kind::List:
+			{
+				// Lists cannot be nested.
+				auto it = _listElement ? listParameters.end() : listParameters.find(part.value);
+				assertThrow(
+					it != listParameters.end(),
+					WhiskersError, "List parameter " + part.value + " not set."
+				);
+				for (auto const& element: it->second)
+				{
+					for (auto const& value: element)
+						assertThrow(!parameters.count(value.first), WhiskersError, "Parameter collision");
+					render(*part.body, &element);
+				}
+				break;
+			}
+			case Part::Kind::Condition:
+			{
+				auto it = conditions.find(part.value);
+				assertThrow(
+					it != conditions.end(),
+					WhiskersError, "Condition parameter " + part.value + " not set."
+				);
+				if (it->second)
+					render(*part.body, _listElement);
+				else if (part.alternative)
+					render(*part.alternative, _listElement);
+				break;
+			}
+			}
+	}
+};
+
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -67,14 +271,23 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	shared_ptr<Template const> parsed = parsedTemplate(m_template);
+
+	// Reserve enough space for the common case that every parameter is used once.
+	size_t size = m_template.size();
+	for (auto const& parameter: m_parameters)
+		size += parameter.second.size();
+	string result;
+	result.reserve(size);
+
+	Renderer{m_parameters, m_conditions, m_listParameters, result}.render(*parsed);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static boost::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		boost::regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -98,73 +311,3 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 		_parameter + " already set as list parameter."
 	);
 }
-
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	using namespace boost;
-	static regex listOrTag("<(" + paramRegex() + ")>|<#(" + paramRegex() + ")>(.*?)</\\2>|<\\?(" + paramRegex() + ")>(.*?)(<!\\4>(.*?))?</\\4>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			assertThrow(
-				_conditions.count(conditionName),
-				WhiskersError, "Condition parameter " + conditionName + " not set."
-			);
-			return replace(
-				_conditions.at(conditionName) ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
-
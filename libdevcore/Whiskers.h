@@ -62,6 +62,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed only once per process and the parsed form is shared by all
+ * instances with the same template text.
  */
 class Whiskers
 {
@@ -90,18 +93,6 @@ private:
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
@@ -29,6 +29,8 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libdevcore/Parallel.h>
+
 #include <fstream>
 #include <json/json.h>
 
@@ -109,6 +111,81 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 	}
 }
 
+vector<unsigned> Assembly::tagPushSizes(unsigned _bytesPerDataRef) const
+{
+	vector<unsigned> sizes(m_items.size(), 0);
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == PushTag)
+		{
+			size_t subId;
+			size_t tagId;
+			tie(subId, tagId) = m_items[i].splitForeignPushTag();
+			// Tags are at most four bytes, see the assertion in assemble().
+			sizes[i] = 4;
+			// The positions of tags in sub-assemblies are already fixed.
+			if (subId != size_t(-1) && subId < m_subs.size())
+			{
+				vector<size_t> const& subTagPositions = m_subs[subId]->m_tagPositionsInBytecode;
+				if (tagId < subTagPositions.size() && subTagPositions[tagId] != size_t(-1))
+					sizes[i] = max<unsigned>(1, dev::bytesRequired(subTagPositions[tagId]));
+			}
+		}
+
+	// Narrowing a push can only move tags to smaller positions, so the sizes of one iteration
+	// are still large enough for the positions of the next one and the iteration terminates.
+	vector<size_t> tagPositions;
+	for (bool changed = true; changed;)
+	{
+		tagPositions.assign(m_usedTags, size_t(-1));
+		size_t position = 0;
+		for (size_t i = 0; i < m_items.size(); ++i)
+		{
+			AssemblyItem const& item = m_items[i];
+			if (item.type() != Tag && tagPositions[0] == size_t(-1))
+				tagPositions[0] = position;
+			switch (item.type())
+			{
+			case PushTag:
+				position += 1 + sizes[i];
+				break;
+			case PushData:
+			case PushSub:
+			case PushProgramSize:
+				position += 1 + _bytesPerDataRef;
+				break;
+			case PushSubSize:
+				position += 1 + max<unsigned>(1, dev::bytesRequired(m_subs.at(size_t(item.data()))->assemble().bytecode.size()));
+				break;
+			case Tag:
+				if (size_t(item.data()) < tagPositions.size())
+					tagPositions[size_t(item.data())] = position;
+				position += 1;
+				break;
+			default:
+				position += item.bytesRequired(_bytesPerDataRef);
+			}
+		}
+
+		changed = false;
+		for (size_t i = 0; i < m_items.size(); ++i)
+			if (m_items[i].type() == PushTag)
+			{
+				size_t subId;
+				size_t tagId;
+				tie(subId, tagId) = m_items[i].splitForeignPushTag();
+				if (subId != size_t(-1) || tagId >= tagPositions.size() || tagPositions[tagId] == size_t(-1))
+					continue;
+				unsigned size = max<unsigned>(1, dev::bytesRequired(tagPositions[tagId]));
+				if (size < sizes[i])
+				{
+					sizes[i] = size;
+					changed = true;
+				}
+			}
+	}
+	return sizes;
+}
+
 namespace
 {
 
@@ -388,24 +465,78 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+vector<vector<size_t>> Assembly::independentSubGroups() const
+{
+	// Union-find over the sub-assemblies, joining those that reach a common assembly.
+	vector<size_t> parent(m_subs.size());
+	for (size_t i = 0; i < parent.size(); ++i)
+		parent[i] = i;
+	function<size_t(size_t)> root = [&](size_t _i) {
+		return parent[_i] == _i ? _i : (parent[_i] = root(parent[_i]));
+	};
+
+	map<Assembly const*, size_t> owner;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		vector<Assembly const*> toVisit{m_subs[subId].get()};
+		set<Assembly const*> visited;
+		while (!toVisit.empty())
+		{
+			Assembly const* assembly = toVisit.back();
+			toVisit.pop_back();
+			if (!visited.insert(assembly).second)
+				continue;
+			auto inserted = owner.insert({assembly, subId});
+			if (!inserted.second)
+			{
+				size_t a = root(inserted.first->second);
+				size_t b = root(subId);
+				// Keep the smaller index as root.
+				parent[max(a, b)] = min(a, b);
+			}
+			for (auto const& sub: assembly->m_subs)
+				toVisit.push_back(sub.get());
+		}
+	}
+
+	vector<vector<size_t>> groups;
+	map<size_t, size_t> groupOfRoot;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		auto inserted = groupOfRoot.insert({root(subId), groups.size()});
+		if (inserted.second)
+			groups.emplace_back();
+		groups[inserted.first->second].push_back(subId);
+	}
+	return groups;
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
-	// Run optimisation for sub-assemblies.
+	// Run optimisation for sub-assemblies. Groups of sub-assemblies that do not share any
+	// assemblies are optimised concurrently, the sub-assemblies inside a group in order.
+	// Replacing the tags of one sub-assembly does not change the references to the others,
+	// so the result is the same as that of optimising them one after the other.
+	vector<vector<size_t>> groups = independentSubGroups();
+	vector<set<size_t>> referencedTags(m_subs.size());
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		referencedTags[subId] = JumpdestRemover::referencedTags(m_items, subId);
+
+	OptimiserSettings settings = _settings;
+	// Disable creation mode for sub-assemblies.
+	settings.isCreation = false;
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	parallelFor(groups.size(), _settings.threads, [&](size_t _group)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		for (size_t subId: groups[_group])
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(settings, move(referencedTags[subId]));
+	});
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -535,12 +666,10 @@ LinkerObject const& Assembly::assemble() const
 
 	size_t bytesRequiredForCode = bytesRequired(subTagSize);
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, -1);
-	map<size_t, pair<size_t, size_t>> tagRef;
+	map<size_t, tuple<size_t, size_t, unsigned>> tagRef; ///< Sub id, tag id and reserved bytes of pushed tags
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
-	unsigned bytesPerTag = dev::bytesRequired(bytesRequiredForCode);
-	uint8_t tagPush = (uint8_t)Instruction::PUSH1 - 1 + bytesPerTag;
 
 	unsigned bytesRequiredIncludingData = bytesRequiredForCode + 1 + m_auxiliaryData.size();
 	for (auto const& sub: m_subs)
@@ -550,8 +679,10 @@ LinkerObject const& Assembly::assemble() const
 	uint8_t dataRefPush = (uint8_t)Instruction::PUSH1 - 1 + bytesPerDataRef;
 	ret.bytecode.reserve(bytesRequiredIncludingData);
 
-	for (AssemblyItem const& i: m_items)
+	vector<unsigned> pushSizes = tagPushSizes(bytesPerDataRef);
+	for (size_t index = 0; index < m_items.size(); ++index)
 	{
+		AssemblyItem const& i = m_items[index];
 		// store position of the invalid jump destination
 		if (i.type() != Tag && m_tagPositionsInBytecode[0] == size_t(-1))
 			m_tagPositionsInBytecode[0] = ret.bytecode.size();
@@ -585,8 +716,12 @@ LinkerObject const& Assembly::assemble() const
 		}
 		case PushTag:
 		{
-			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			unsigned bytesPerTag = pushSizes[index];
+			ret.bytecode.push_back((uint8_t)Instruction::PUSH1 - 1 + bytesPerTag);
+			size_t subId;
+			size_t tagId;
+			tie(subId, tagId) = i.splitForeignPushTag();
+			tagRef[ret.bytecode.size()] = make_tuple(subId, tagId, bytesPerTag);
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -660,7 +795,8 @@ LinkerObject const& Assembly::assemble() const
 	{
 		size_t subId;
 		size_t tagId;
-		tie(subId, tagId) = i.second;
+		unsigned bytesPerTag;
+		tie(subId, tagId, bytesPerTag) = i.second;
 		assertThrow(subId == size_t(-1) || subId < m_subs.size(), AssemblyException, "Invalid sub id");
 		std::vector<size_t> const& tagPositions =
 			subId == size_t(-1) ?
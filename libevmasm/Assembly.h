@@ -111,6 +111,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Number of threads used to optimise independent sub-assemblies concurrently.
+		/// Does not influence the result.
+		unsigned threads = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -156,8 +159,15 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns the indices of the sub-assemblies, grouped such that sub-assemblies of different
+	/// groups do not share any (nested) assemblies. Groups are ordered by their first index.
+	std::vector<std::vector<size_t>> independentSubGroups() const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
+	/// @returns, for every item, the number of bytes used to push the tag if it is a PushTag and zero
+	/// otherwise. All pushes start with four bytes and are narrowed to the size of the tag position
+	/// until the positions do not change anymore. Requires the sub-assemblies to be assembled.
+	std::vector<unsigned> tagPushSizes(unsigned _bytesPerDataRef) const;
 
 private:
 	static Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string());
@@ -26,8 +26,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <map>
+#include <tuple>
 
 using namespace std;
 using namespace dev;
@@ -36,65 +36,111 @@ using namespace dev::eth;
 
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
-	// opcodes that stop the control flow.
-
-	// Virtual tag that signifies "the current block" and which is used to optimise loops.
-	// We abort if this virtual tag actually exists.
-	AssemblyItem pushSelf{PushTag, u256(-4)};
-	if (
-		std::count(m_items.cbegin(), m_items.cend(), pushSelf.tag()) ||
-		std::count(m_items.cbegin(), m_items.cend(), pushSelf.pushTag())
-	)
-		return false;
-
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	// Two tags are equivalent if the item sequences that start there are equal, ignoring tags
+	// and stopping at opcodes that stop the control flow, where pushes of equivalent tags
+	// are considered equal. This also unifies loops and mutually recursive blocks.
+	//
+	// Every non-tag item is a state whose successor is the next non-tag item (if the item
+	// does not stop the control flow) and a tag is represented by the state it falls through
+	// to. We start with a partition of the states by the hash of their item sequence, where
+	// all tags pushed inside this assembly are regarded as equal, and refine it until the
+	// classes of the successors and of the pushed tags are consistent inside every class.
+
+	size_t const none = size_t(-1);
+	// The state after the last item.
+	size_t const endState = m_items.size();
+
+	// Maps the data of every tag to the state it represents.
+	map<u256, size_t> tagStates;
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		BlockIterator first{m_items.begin() + _i, m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + _j, m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
-	};
+		size_t state = endState;
+		for (size_t i = m_items.size(); i-- > 0;)
+			if (m_items[i].type() == Tag)
+				tagStates[m_items[i].data()] = state;
+			else
+				state = i;
+	}
+	if (tagStates.empty())
+		return false;
 
-	size_t iterations = 0;
-	for (; ; ++iterations)
+	// Item labels (with local tags removed), successors and pushed tags of the states.
+	AssemblyItem const localPushTag{PushTag, 0};
+	map<AssemblyItem, size_t> labelIds;
+	vector<size_t> labels(m_items.size() + 1, none);
+	vector<size_t> successors(m_items.size() + 1, none);
+	vector<size_t> targets(m_items.size() + 1, none);
+	vector<size_t> classes(m_items.size() + 1, none);
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
-		for (size_t i = 0; i < m_items.size(); ++i)
+		uint64_t const fnvPrime = 1099511628211u;
+		uint64_t const fnvEmptyHash = 14695981039346656037u;
+		vector<uint64_t> hashes(m_items.size() + 1, fnvEmptyHash);
+		size_t next = endState;
+		for (size_t i = m_items.size(); i-- > 0;)
 		{
-			if (m_items.at(i).type() != Tag)
+			AssemblyItem const& item = m_items[i];
+			if (item.type() == Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
-			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+			AssemblyItem const* label = &item;
+			if (item.type() == PushTag)
+			{
+				auto target = tagStates.find(item.data());
+				if (target != tagStates.end())
+				{
+					targets[i] = target->second;
+					label = &localPushTag;
+				}
+			}
+			labels[i] = labelIds.emplace(*label, labelIds.size()).first->second;
+			if (!SemanticInformation::altersControlFlow(item) || item == Instruction::JUMPI)
+				successors[i] = next;
+			hashes[i] = ((successors[i] == none ? 0 : hashes[successors[i]]) * fnvPrime) ^ uint64_t(labels[i]);
+			next = i;
 		}
 
-		if (!applyTagReplacement(m_items, m_replacedTags))
+		map<uint64_t, size_t> hashClasses;
+		for (size_t state = 0; state <= endState; ++state)
+			if (state == endState || labels[state] != none)
+				classes[state] = hashClasses.emplace(hashes[state], hashClasses.size()).first->second;
+	}
+
+	// Moore-style refinement, the item labels make hash collisions harmless. A round only
+	// splits classes whose states differ in the classes of their successors or pushed tags,
+	// so the number of rounds is bounded by the number of classes.
+	for (size_t classCount = 0; ;)
+	{
+		map<tuple<size_t, size_t, size_t, size_t>, size_t> signatures;
+		vector<size_t> refined(classes.size(), none);
+		for (size_t state = 0; state <= endState; ++state)
+			if (classes[state] != none)
+				refined[state] = signatures.emplace(
+					make_tuple(
+						classes[state],
+						labels[state],
+						successors[state] == none ? none : classes[successors[state]],
+						targets[state] == none ? none : classes[targets[state]]
+					),
+					signatures.size()
+				).first->second;
+		classes = move(refined);
+		if (signatures.size() == classCount)
 			break;
+		classCount = signatures.size();
 	}
-	return iterations > 0;
+
+	// Replace every tag by the first tag of its class.
+	map<size_t, u256> representatives;
+	for (AssemblyItem const& item: m_items)
+		if (item.type() == Tag)
+		{
+			u256 const& representative = representatives.emplace(
+				classes[tagStates.at(item.data())],
+				item.data()
+			).first->second;
+			if (representative != item.data())
+				m_replacedTags[item.data()] = representative;
+		}
+
+	return applyTagReplacement(m_items, m_replacedTags);
 }
 
 bool BlockDeduplicator::applyTagReplacement(
@@ -121,26 +167,3 @@ bool BlockDeduplicator::applyTagReplacement(
 		}
 	return changed;
 }
-
-BlockDeduplicator::BlockIterator& BlockDeduplicator::BlockIterator::operator++()
-{
-	if (it == end)
-		return *this;
-	if (SemanticInformation::altersControlFlow(*it) && *it != AssemblyItem{Instruction::JUMPI})
-		it = end;
-	else
-	{
-		++it;
-		while (it != end && it->type() == Tag)
-			++it;
-	}
-	return *this;
-}
-
-AssemblyItem const& BlockDeduplicator::BlockIterator::operator*() const
-{
-	if (replaceItem && replaceWith && *it == *replaceItem)
-		return *replaceWith;
-	else
-		return *it;
-}
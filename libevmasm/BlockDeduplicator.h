@@ -27,7 +27,6 @@
 
 #include <cstddef>
 #include <vector>
-#include <functional>
 #include <map>
 
 namespace dev
@@ -40,7 +39,11 @@ using AssemblyItems = std::vector<AssemblyItem>;
 
 /**
  * Optimizer class to be used to unify blocks that share content.
- * Modifies the passed vector in place.
+ * Also unifies loops and mutually recursive blocks. Modifies the passed vector in place.
+ * The blocks are compared by partition refinement, where every round takes O(n log n) time
+ * for n items. Each round can split off as little as one class, so there can be up to n
+ * rounds and the worst case is O(n^2 log n). In practice, a difference only has to be
+ * propagated along the tags that blocks push, which takes a few rounds.
  */
 class BlockDeduplicator
 {
@@ -62,29 +65,6 @@ public:
 	);
 
 private:
-	/// Iterator that skips tags and skips to the end if (all branches of) the control
-	/// flow does not continue to the next instruction.
-	/// If the arguments are supplied to the constructor, replaces items on the fly.
-	struct BlockIterator: std::iterator<std::forward_iterator_tag, AssemblyItem const>
-	{
-	public:
-		BlockIterator(
-			AssemblyItems::const_iterator _it,
-			AssemblyItems::const_iterator _end,
-			AssemblyItem const* _replaceItem = nullptr,
-			AssemblyItem const* _replaceWith = nullptr
-		):
-			it(_it), end(_end), replaceItem(_replaceItem), replaceWith(_replaceWith) {}
-		BlockIterator& operator++();
-		bool operator==(BlockIterator const& _other) const { return it == _other.it; }
-		bool operator!=(BlockIterator const& _other) const { return it != _other.it; }
-		AssemblyItem const& operator*() const;
-		AssemblyItems::const_iterator it;
-		AssemblyItems::const_iterator end;
-		AssemblyItem const* replaceItem;
-		AssemblyItem const* replaceWith;
-	};
-
 	std::map<u256, u256> m_replacedTags;
 	AssemblyItems& m_items;
 };
@@ -22,10 +22,41 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+
+/// Representations found by ComputeMethod. They depend on all parameters that enter the
+/// gas computation, not only on the value.
+struct RepresentationCache
+{
+	/// Value, whether it is creation code, runs, multiplicity and EVM version.
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+	/// The cache is cleared when it reaches this size, so that long-running processes
+	/// do not accumulate constants.
+	static size_t constexpr maxEntries = 65536;
+
+	std::mutex mutex;
+	map<Key, AssemblyItems> routines;
+	/// Number of lookups that found a representation since the cache was last cleared explicitly.
+	size_t hits = 0;
+};
+
+RepresentationCache& representationCache()
+{
+	static RepresentationCache cache;
+	return cache;
+}
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -185,6 +216,50 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	RepresentationCache& cache = representationCache();
+	RepresentationCache::Key key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	{
+		lock_guard<mutex> lock(cache.mutex);
+		auto it = cache.routines.find(key);
+		if (it != cache.routines.end())
+		{
+			cache.hits++;
+			m_routine = it->second;
+			return;
+		}
+	}
+
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+
+	lock_guard<mutex> lock(cache.mutex);
+	if (cache.routines.size() >= RepresentationCache::maxEntries)
+		cache.routines.clear();
+	cache.routines.emplace(move(key), m_routine);
+}
+
+void ComputeMethod::clearCache()
+{
+	RepresentationCache& cache = representationCache();
+	lock_guard<mutex> lock(cache.mutex);
+	cache.routines.clear();
+	cache.hits = 0;
+}
+
+size_t ComputeMethod::cacheHits()
+{
+	RepresentationCache& cache = representationCache();
+	lock_guard<mutex> lock(cache.mutex);
+	return cache.hits;
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -130,20 +130,18 @@ protected:
 
 /**
  * Method that tries to compute the constant.
+ * The same constants (masks, function selectors, ...) occur in many contracts, so the computed
+ * representations are stored in a cache that is shared by all threads of the process.
  */
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
+
+	/// Removes all representations from the process-wide cache.
+	static void clearCache();
+	/// @returns how often a representation was taken from the cache since the last call to clearCache.
+	static size_t cacheHits();
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
@@ -168,64 +168,47 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 					);
 			}
 		}
-		m_stackElements.erase(
-			m_stackElements.upper_bound(m_stackHeight + _item.deposit()),
-			m_stackElements.end()
-		);
+		m_stackElements.eraseAbove(m_stackHeight + _item.deposit());
 		m_stackHeight += _item.deposit();
 	}
 	return op;
 }
 
-/// Helper function for KnownState::reduceToCommonKnowledge, removes everything from
-/// _this which is not in or not equal to the value in _other.
-template <class _Mapping> void intersect(_Mapping& _this, _Mapping const& _other)
-{
-	for (auto it = _this.begin(); it != _this.end();)
-		if (_other.count(it->first) && _other.at(it->first) == it->second)
-			++it;
-		else
-			it = _this.erase(it);
-}
-
 void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers)
 {
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (_other.m_stackElements.count(it->first - stackDiff))
+	// Use the smaller stack height. Essential to terminate in case of loops.
+	int shift = max(stackDiff, 0);
+	if (stackDiff != 0 || m_stackElements != _other.m_stackElements)
+	{
+		// Without a shift, the elements are modified in a copy, so that unchanged parts stay shared.
+		PersistentMap<int, Id> stackElements = shift ? PersistentMap<int, Id>() : m_stackElements;
+		for (auto const& stackElement: m_stackElements)
 		{
-			Id other = _other.m_stackElements.at(it->first - stackDiff);
-			if (it->second == other)
-				++it;
-			else
+			Id const* other = _other.m_stackElements.find(stackElement.first - stackDiff);
+			if (other && stackElement.second == *other)
 			{
-				set<u256> theseTags = tagsInExpression(it->second);
-				set<u256> otherTags = tagsInExpression(other);
-				if (!theseTags.empty() && !otherTags.empty())
-				{
-					theseTags.insert(otherTags.begin(), otherTags.end());
-					it->second = tagUnion(theseTags);
-					++it;
-				}
-				else
-					it = m_stackElements.erase(it);
+				if (shift)
+					stackElements.set(stackElement.first - shift, stackElement.second);
+				continue;
 			}
+			set<u256> theseTags = other ? tagsInExpression(stackElement.second) : set<u256>();
+			set<u256> otherTags = other ? tagsInExpression(*other) : set<u256>();
+			if (!theseTags.empty() && !otherTags.empty())
+			{
+				theseTags.insert(otherTags.begin(), otherTags.end());
+				stackElements.set(stackElement.first - shift, tagUnion(theseTags));
+			}
+			else if (!shift)
+				stackElements.erase(stackElement.first);
 		}
-		else
-			it = m_stackElements.erase(it);
-
-	// Use the smaller stack height. Essential to terminate in case of loops.
-	if (m_stackHeight > _other.m_stackHeight)
-	{
-		map<int, Id> shiftedStack;
-		for (auto const& stackElement: m_stackElements)
-			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
-		m_stackElements = move(shiftedStack);
-		m_stackHeight = _other.m_stackHeight;
+		m_stackElements = move(stackElements);
 	}
+	if (shift)
+		m_stackHeight = _other.m_stackHeight;
 
-	intersect(m_storageContent, _other.m_storageContent);
-	intersect(m_memoryContent, _other.m_memoryContent);
+	m_storageContent.intersect(_other.m_storageContent);
+	m_memoryContent.intersect(_other.m_memoryContent);
 	if (_combineSequenceNumbers)
 		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
 }
@@ -235,21 +218,37 @@ bool KnownState::operator==(KnownState const& _other) const
 	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
 		return false;
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	auto thisIt = m_stackElements.cbegin();
-	auto otherIt = _other.m_stackElements.cbegin();
-	for (; thisIt != m_stackElements.cend() && otherIt != _other.m_stackElements.cend(); ++thisIt, ++otherIt)
+	if (stackDiff == 0)
+		return m_stackElements == _other.m_stackElements;
+	auto thisIt = m_stackElements.begin();
+	auto otherIt = _other.m_stackElements.begin();
+	for (; thisIt != m_stackElements.end() && otherIt != _other.m_stackElements.end(); ++thisIt, ++otherIt)
 		if (thisIt->first - stackDiff != otherIt->first || thisIt->second != otherIt->second)
 			return false;
-	return (thisIt == m_stackElements.cend() && otherIt == _other.m_stackElements.cend());
+	return (thisIt == m_stackElements.end() && otherIt == _other.m_stackElements.end());
+}
+
+bool KnownState::isIdenticalTo(KnownState const& _other) const
+{
+	return
+		m_expressionClasses == _other.m_expressionClasses &&
+		m_stackHeight == _other.m_stackHeight &&
+		m_sequenceNumber == _other.m_sequenceNumber &&
+		m_stackElements == _other.m_stackElements &&
+		m_storageContent == _other.m_storageContent &&
+		m_memoryContent == _other.m_memoryContent &&
+		m_knownKeccak256Hashes == _other.m_knownKeccak256Hashes &&
+		m_tagUnions.left == _other.m_tagUnions.left;
 }
 
 ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation const& _location)
 {
-	if (m_stackElements.count(_stackHeight))
-		return m_stackElements.at(_stackHeight);
+	if (Id const* id = m_stackElements.find(_stackHeight))
+		return *id;
 	// Stack element not found (not assigned yet), create new unknown equivalence class.
-	return m_stackElements[_stackHeight] =
-			m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
+	Id id = m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
+	m_stackElements.set(_stackHeight, id);
+	return id;
 }
 
 KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation const& _location)
@@ -259,16 +258,17 @@ KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation
 
 void KnownState::clearTagUnions()
 {
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (m_tagUnions.left.count(it->second))
-			it = m_stackElements.erase(it);
-		else
-			++it;
+	vector<int> tagUnionElements;
+	for (auto const& stackElement: m_stackElements)
+		if (m_tagUnions.left.count(stackElement.second))
+			tagUnionElements.push_back(stackElement.first);
+	for (int stackHeight: tagUnionElements)
+		m_stackElements.erase(stackHeight);
 }
 
 void KnownState::setStackElement(int _stackHeight, Id _class)
 {
-	m_stackElements[_stackHeight] = _class;
+	m_stackElements.set(_stackHeight, _class);
 }
 
 void KnownState::swapStackElements(
@@ -279,10 +279,11 @@ void KnownState::swapStackElements(
 {
 	assertThrow(_stackHeightA != _stackHeightB, OptimizerException, "Swap on same stack elements.");
 	// ensure they are created
-	stackElement(_stackHeightA, _location);
-	stackElement(_stackHeightB, _location);
+	Id a = stackElement(_stackHeightA, _location);
+	Id b = stackElement(_stackHeightB, _location);
 
-	swap(m_stackElements[_stackHeightA], m_stackElements[_stackHeightB]);
+	m_stackElements.set(_stackHeightA, b);
+	m_stackElements.set(_stackHeightB, a);
 }
 
 KnownState::StoreOperation KnownState::storeInStorage(
@@ -290,23 +291,23 @@ KnownState::StoreOperation KnownState::storeInStorage(
 	Id _value,
 	SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot) && m_storageContent[_slot] == _value)
+	if (m_storageContent.count(_slot) && m_storageContent.at(_slot) == _value)
 		// do not execute the storage if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_storageContent) storageContents;
-	// Copy over all values (i.e. retain knowledge about them) where we know that this store
-	// operation will not destroy the knowledge. Specifically, we copy storage locations we know
-	// are different from _slot or locations where we know that the stored value is equal to _value.
-	for (auto const& storageItem: m_storageContent)
-		if (m_expressionClasses->knownToBeDifferent(storageItem.first, _slot) || storageItem.second == _value)
-			storageContents.insert(storageItem);
-	m_storageContent = move(storageContents);
+	// Retain knowledge about all values where we know that this store operation will not
+	// destroy the knowledge. Specifically, we keep storage locations we know are different
+	// from _slot or locations where we know that the stored value is equal to _value.
+	// The loop iterates over a copy, which also keeps the unchanged parts shared.
+	auto const storageContent = m_storageContent;
+	for (auto const& storageItem: storageContent)
+		if (!m_expressionClasses->knownToBeDifferent(storageItem.first, _slot) && storageItem.second != _value)
+			m_storageContent.erase(storageItem.first);
 
 	AssemblyItem item(Instruction::SSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Storage, _slot, m_sequenceNumber, id};
-	m_storageContent[_slot] = _value;
+	m_storageContent.set(_slot, _value);
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 
@@ -315,30 +316,31 @@ KnownState::StoreOperation KnownState::storeInStorage(
 
 ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot))
-		return m_storageContent.at(_slot);
+	if (Id const* value = m_storageContent.find(_slot))
+		return *value;
 
 	AssemblyItem item(Instruction::SLOAD, _location);
-	return m_storageContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	Id value = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	m_storageContent.set(_slot, value);
+	return value;
 }
 
 KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot) && m_memoryContent[_slot] == _value)
+	if (m_memoryContent.count(_slot) && m_memoryContent.at(_slot) == _value)
 		// do not execute the store if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_memoryContent) memoryContents;
-	// copy over values at points where we know that they are different from _slot by at least 32
-	for (auto const& memoryItem: m_memoryContent)
-		if (m_expressionClasses->knownToBeDifferentBy32(memoryItem.first, _slot))
-			memoryContents.insert(memoryItem);
-	m_memoryContent = move(memoryContents);
+	// keep values at points where we know that they are different from _slot by at least 32
+	auto const memoryContent = m_memoryContent;
+	for (auto const& memoryItem: memoryContent)
+		if (!m_expressionClasses->knownToBeDifferentBy32(memoryItem.first, _slot))
+			m_memoryContent.erase(memoryItem.first);
 
 	AssemblyItem item(Instruction::MSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Memory, _slot, m_sequenceNumber, id};
-	m_memoryContent[_slot] = _value;
+	m_memoryContent.set(_slot, _value);
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 	return operation;
@@ -346,11 +348,13 @@ KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, Source
 
 ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot))
-		return m_memoryContent.at(_slot);
+	if (Id const* value = m_memoryContent.find(_slot))
+		return *value;
 
 	AssemblyItem item(Instruction::MLOAD, _location);
-	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	Id value = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	m_memoryContent.set(_slot, value);
+	return value;
 }
 
 KnownState::Id KnownState::applyKeccak256(
@@ -375,8 +379,8 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count(arguments))
-		return m_knownKeccak256Hashes.at(arguments);
+	if (Id const* hash = m_knownKeccak256Hashes.find(arguments))
+		return *hash;
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -389,7 +393,8 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[arguments] = v;
+	m_knownKeccak256Hashes.set(arguments, v);
+	return v;
 }
 
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
@@ -43,6 +43,7 @@
 
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/Exceptions.h>
+#include <libdevcore/PersistentMap.h>
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
 
@@ -66,6 +67,9 @@ using AssemblyItems = std::vector<AssemblyItem>;
  * The general workings are that for each assembly item that is fed, an equivalence class is
  * derived from the operation and the equivalence class of its arguments. DUPi, SWAPi and some
  * arithmetic instructions are used to infer equivalences while these classes are determined.
+ *
+ * The knowledge is stored in persistent maps, so copies of a state are cheap and share
+ * most of their memory.
  */
 class KnownState
 {
@@ -113,11 +117,16 @@ public:
 	/// @param _combineSequenceNumbers if true, sets the sequence number to the maximum of both
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
-	/// @returns a shared pointer to a copy of this state.
+	/// @returns a shared pointer to a copy of this state. The knowledge about the stack,
+	/// storage and memory is shared with this state until one of them is modified.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
 	bool operator==(KnownState const& _other) const;
+	/// @returns true if both states use the same expression classes and do not differ in any way,
+	/// including stack height and sequence number, so that feeding the same items to them has
+	/// the same effect.
+	bool isIdenticalTo(KnownState const& _other) const;
 
 	/// Retrieves the current equivalence class fo the given stack element (or generates a new
 	/// one if it does not exist yet).
@@ -133,10 +142,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	PersistentMap<int, Id> const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	PersistentMap<Id, Id> const& storageContent() const { return m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -165,16 +174,16 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	PersistentMap<int, Id> m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	PersistentMap<Id, Id> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	PersistentMap<Id, Id> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	PersistentMap<std::vector<Id>, Id> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
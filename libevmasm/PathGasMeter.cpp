@@ -27,8 +27,15 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+size_t constexpr PathGasMeter::defaultStepLimit;
+
+PathGasMeter::PathGasMeter(
+	AssemblyItems const& _items,
+	langutil::EVMVersion _evmVersion,
+	size_t _stepLimit,
+	bool _memoise
+):
+	m_items(_items), m_evmVersion(_evmVersion), m_stepLimit(_stepLimit), m_memoise(_memoise)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -51,6 +58,17 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	return gas;
 }
 
+bool PathGasMeter::isStraightLine(size_t _index) const
+{
+	AssemblyItem const& item = m_items.at(_index);
+	return
+		item.type() != Tag &&
+		item != AssemblyItem(Instruction::JUMPDEST) &&
+		item != AssemblyItem(Instruction::JUMP) &&
+		item != AssemblyItem(Instruction::JUMPI) &&
+		!SemanticInformation::altersControlFlow(item);
+}
+
 void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
 {
 	if (
@@ -84,6 +102,48 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 	set<u256> jumpTags;
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
+		if (isStraightLine(index) && (index == path->index || !isStraightLine(index - 1)))
+		{
+			size_t end = index;
+			while (end < m_items.size() && isStraightLine(end))
+				++end;
+			vector<BlockSummary>& summaries = m_blockSummaries[index];
+			auto summary = find_if(summaries.begin(), summaries.end(), [&](BlockSummary const& _summary) {
+				return
+					_summary.entryMemoryAccess == meter.largestMemoryAccess() &&
+					_summary.entryState->isIdenticalTo(*state);
+			});
+			if (summary != summaries.end())
+			{
+				++m_steps;
+				gas += summary->gas;
+				state = summary->exitState->copy();
+				meter = GasMeter(state, m_evmVersion, summary->exitMemoryAccess);
+			}
+			else
+			{
+				m_steps += end - index;
+				if (m_steps > m_stepLimit)
+					return GasMeter::GasConsumption::infinite();
+				BlockSummary newSummary{state->copy(), meter.largestMemoryAccess(), {}, nullptr, 0};
+				for (size_t i = index; i < end && !newSummary.gas.isInfinite; ++i)
+					newSummary.gas += meter.estimateMax(m_items.at(i));
+				gas += newSummary.gas;
+				newSummary.exitState = state->copy();
+				newSummary.exitMemoryAccess = meter.largestMemoryAccess();
+				// Only few blocks are reached with different states, do not keep too many of them.
+				if (m_memoise && summaries.size() < 8)
+					summaries.emplace_back(move(newSummary));
+			}
+			if (m_steps > m_stepLimit)
+				return GasMeter::GasConsumption::infinite();
+			// Continue with the item that ends the block.
+			index = end - 1;
+			continue;
+		}
+
+		if (++m_steps > m_stepLimit)
+			return GasMeter::GasConsumption::infinite();
 		bool branchStops = false;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
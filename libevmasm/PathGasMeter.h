@@ -25,6 +25,7 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <vector>
 #include <memory>
@@ -49,14 +50,31 @@ struct GasPath
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ *
+ * The gas and the effect of the straight-line code between two jumps or jump destinations
+ * are memoised, so paths that reach such a block again with the same knowledge do not
+ * have to analyse it again. The number of items analysed by one instance is limited,
+ * the estimate is infinite if the limit is exceeded.
  */
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// Default for the number of items an instance analyses before giving up.
+	static size_t constexpr defaultStepLimit = 1000000;
+
+	/// If @a _memoise is false, every block is analysed again each time a path reaches it.
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _stepLimit = defaultStepLimit,
+		bool _memoise = true
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
+	/// @returns the number of items analysed so far, where a memoised block counts as one.
+	size_t steps() const { return m_steps; }
+
 	static GasMeter::GasConsumption estimateMax(
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
@@ -68,6 +86,20 @@ public:
 	}
 
 private:
+	/// Gas and effect of the items between two control flow items for one starting state.
+	struct BlockSummary
+	{
+		std::shared_ptr<KnownState const> entryState;
+		u256 entryMemoryAccess;
+		GasMeter::GasConsumption gas;
+		std::shared_ptr<KnownState const> exitState;
+		u256 exitMemoryAccess;
+	};
+
+	/// @returns true if the item at @a _index neither is a jump destination nor changes
+	/// the control flow.
+	bool isStraightLine(size_t _index) const;
+
 	/// Adds a new path item to the queue, but only if we do not already have
 	/// a higher gas usage at that point.
 	/// This is not exact as different state might influence higher gas costs at a later
@@ -80,8 +112,14 @@ private:
 	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
 	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
 	std::map<u256, size_t> m_tagPositions;
+	/// Summaries of the blocks starting at a certain index, for different starting states.
+	std::map<size_t, std::vector<BlockSummary>> m_blockSummaries;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	size_t m_stepLimit;
+	bool m_memoise;
+	/// Number of items analysed so far, a memoised block counts as one.
+	size_t m_steps = 0;
 };
 
 }
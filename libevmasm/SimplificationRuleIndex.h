@@ -0,0 +1,217 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Discrimination tree that selects the simplification rules that can match an expression.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+/**
+ * Shape of a node of a pattern or of an expression, i.e. what the index knows about it.
+ * For expressions, Any means that the node is neither an operation nor a constant.
+ */
+struct PatternShape
+{
+	enum class Kind { Operation, Constant, Any };
+
+	Kind kind = Kind::Any;
+	/// Only valid for Operation.
+	Instruction instruction = Instruction::STOP;
+	/// Only valid for Constant. Empty for patterns that match any constant.
+	boost::optional<u256> value;
+};
+
+/**
+ * Index over the patterns of a list of simplification rules that, for a given expression,
+ * quickly determines the rules whose patterns can match the expression with respect to
+ * the nested operations and constants. The rules still have to be matched against the
+ * returned candidates, since the index ignores match groups.
+ *
+ * The patterns are flattened in pre-order, and these sequences form the paths from the
+ * root of the tree to its leaves, which store the rules. To look up an expression, it is
+ * traversed together with the tree, following all edges that are compatible with it.
+ *
+ * @a Pattern has to provide `PatternShape shape() const` and `arguments()`.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	/// Builds the index for the patterns of @a _rules. The candidates are indices into @a _rules.
+	template <class Rule>
+	explicit SimplificationRuleIndex(std::vector<Rule> const& _rules)
+	{
+		m_nodes.emplace_back();
+		for (size_t i = 0; i < _rules.size(); ++i)
+			m_nodes[insert(0, _rules[i].pattern)].rules.push_back(i);
+	}
+
+	/// Stores the indices of the rules that can match @a _expression in ascending order in @a o_rules.
+	/// @param _shapeOf is called as `PatternShape _shapeOf(Expression const&, std::vector<Expression const*>& io_arguments)`
+	/// and has to determine the shape of an expression and append its arguments if it is an operation,
+	/// without modifying the elements already present.
+	/// @param io_buffer is only used as temporary storage. Lookups are done for every expression
+	/// the optimiser sees, so callers keep their buffers to avoid allocations.
+	template <class Expression, class ShapeOf>
+	void candidates(
+		Expression const& _expression,
+		ShapeOf const& _shapeOf,
+		std::vector<size_t>& o_rules,
+		std::vector<Expression const*>& io_buffer
+	) const
+	{
+		o_rules.clear();
+		io_buffer.clear();
+		io_buffer.push_back(&_expression);
+		collect(0, io_buffer, _shapeOf, o_rules);
+		std::sort(o_rules.begin(), o_rules.end());
+	}
+
+private:
+	/// Children of a node sorted by their key. There are only few of them and lookups are far
+	/// more frequent than insertions, so this is faster than a std::map.
+	template <class Key>
+	using Children = std::vector<std::pair<Key, size_t>>;
+
+	struct Node
+	{
+		/// Children for operations, keyed by the instruction and the number of arguments of the pattern.
+		/// Patterns without arguments match operations with any arguments.
+		Children<std::pair<Instruction, size_t>> operations;
+		/// Children for specific constants.
+		Children<u256> constants;
+		/// Child for patterns that match any constant, zero if there is none.
+		size_t anyConstant = 0;
+		/// Child for patterns that match anything, zero if there is none.
+		size_t any = 0;
+		/// Rules whose patterns end at this node.
+		std::vector<size_t> rules;
+	};
+
+	/// Adds the path for @a _pattern starting at @a _node and @returns the node it ends at.
+	size_t insert(size_t _node, Pattern const& _pattern)
+	{
+		PatternShape shape = _pattern.shape();
+		if (shape.kind == PatternShape::Kind::Any)
+			return childFor(m_nodes[_node].any);
+		else if (shape.kind == PatternShape::Kind::Constant)
+			return shape.value ? childFor(entry(m_nodes[_node].constants, *shape.value)) : childFor(m_nodes[_node].anyConstant);
+
+		auto arguments = _pattern.arguments();
+		size_t node = childFor(entry(m_nodes[_node].operations, std::make_pair(shape.instruction, arguments.size())));
+		for (Pattern const& argument: arguments)
+			node = insert(node, argument);
+		return node;
+	}
+
+	/// @returns a reference to the child stored under @a _key, which is zero if it was not present.
+	template <class Key>
+	static size_t& entry(Children<Key>& _children, Key const& _key)
+	{
+		auto it = std::lower_bound(_children.begin(), _children.end(), _key, [](auto const& _child, Key const& _k) { return _child.first < _k; });
+		if (it == _children.end() || _key < it->first)
+			it = _children.insert(it, std::make_pair(_key, size_t(0)));
+		return it->second;
+	}
+	/// @returns the child stored under @a _key or zero if there is none.
+	template <class Key>
+	static size_t find(Children<Key> const& _children, Key const& _key)
+	{
+		auto it = std::lower_bound(_children.begin(), _children.end(), _key, [](auto const& _child, Key const& _k) { return _child.first < _k; });
+		return it != _children.end() && !(_key < it->first) ? it->second : 0;
+	}
+
+	/// @returns the node stored in @a _child, after creating it if it is zero.
+	size_t childFor(size_t& _child)
+	{
+		if (_child)
+			return _child;
+		// Adding a node can invalidate the reference, so it is not used afterwards.
+		size_t index = m_nodes.size();
+		_child = index;
+		m_nodes.emplace_back();
+		return index;
+	}
+
+	/// Follows all edges of @a _node that are compatible with the expressions in @a _pending,
+	/// the next one of which is at the back, and appends the rules at the end of the paths to @a o_rules.
+	/// Restores @a _pending before it returns.
+	template <class Expression, class ShapeOf>
+	void collect(
+		size_t _node,
+		std::vector<Expression const*>& _pending,
+		ShapeOf const& _shapeOf,
+		std::vector<size_t>& o_rules
+	) const
+	{
+		Node const& node = m_nodes[_node];
+		if (_pending.empty())
+		{
+			o_rules.insert(o_rules.end(), node.rules.begin(), node.rules.end());
+			return;
+		}
+
+		Expression const* expression = _pending.back();
+		_pending.pop_back();
+		if (node.any)
+			collect(node.any, _pending, _shapeOf, o_rules);
+
+		// The arguments are appended to the pending expressions directly, which avoids
+		// allocating a vector for every visited node.
+		size_t const pendingSize = _pending.size();
+		PatternShape shape = _shapeOf(*expression, _pending);
+		size_t const argumentCount = _pending.size() - pendingSize;
+		if (shape.kind == PatternShape::Kind::Operation)
+		{
+			std::reverse(_pending.begin() + pendingSize, _pending.end());
+			if (size_t child = argumentCount ? find(node.operations, std::make_pair(shape.instruction, argumentCount)) : 0)
+				collect(child, _pending, _shapeOf, o_rules);
+			_pending.resize(pendingSize);
+			if (size_t child = find(node.operations, std::make_pair(shape.instruction, size_t(0))))
+				collect(child, _pending, _shapeOf, o_rules);
+		}
+		else if (shape.kind == PatternShape::Kind::Constant)
+		{
+			if (node.anyConstant)
+				collect(node.anyConstant, _pending, _shapeOf, o_rules);
+			if (size_t child = find(node.constants, *shape.value))
+				collect(child, _pending, _shapeOf, o_rules);
+		}
+
+		_pending.push_back(expression);
+	}
+
+	std::vector<Node> m_nodes;
+};
+
+}
+}
@@ -48,8 +48,29 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	// The index only refers to the rules by position, so it can be shared by all instances.
+	static SimplificationRuleIndex<Pattern> const index(m_rules);
+	auto shapeOf = [&](Expression const& _expression, vector<Expression const*>& o_arguments)
 	{
+		PatternShape shape;
+		if (_expression.item && _expression.item->type() == Operation)
+		{
+			shape.kind = PatternShape::Kind::Operation;
+			shape.instruction = _expression.item->instruction();
+			for (ExpressionClasses::Id argument: _expression.arguments)
+				o_arguments.push_back(&_classes.representative(argument));
+		}
+		else if (_expression.item && _expression.item->type() == Push)
+		{
+			shape.kind = PatternShape::Kind::Constant;
+			shape.value = _expression.item->data();
+		}
+		return shape;
+	};
+	index.candidates(_expr, shapeOf, m_candidates, m_pendingExpressions);
+	for (size_t ruleIndex: m_candidates)
+	{
+		auto const& rule = m_rules[ruleIndex];
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -61,7 +82,7 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -72,7 +93,8 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	assertThrow(_rule.pattern.type() == Operation, OptimizerException, "Rules have to start with an operation.");
+	m_rules.push_back(_rule);
 }
 
 Rules::Rules()
@@ -126,6 +148,25 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+PatternShape Pattern::shape() const
+{
+	PatternShape shape;
+	if (m_type == Operation)
+	{
+		shape.kind = PatternShape::Kind::Operation;
+		shape.instruction = m_instruction;
+	}
+	else if (m_type == Push)
+	{
+		shape.kind = PatternShape::Kind::Constant;
+		if (m_requireDataMatch)
+			shape.value = data();
+	}
+	else
+		assertThrow(m_type == UndefinedItem, OptimizerException, "Pattern cannot be indexed.");
+	return shape;
+}
+
 AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 {
 	if (m_type == Operation)
@@ -25,6 +25,7 @@
 
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <boost/noncopyable.hpp>
 
@@ -54,7 +55,7 @@ public:
 	Rules();
 
 	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// groups accordingly. Only the rules selected by the rule index are tried.
 	SimplificationRule<Pattern> const* findFirstMatch(
 		Expression const& _expr,
 		ExpressionClasses const& _classes
@@ -73,7 +74,10 @@ private:
 	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	std::vector<SimplificationRule<Pattern>> m_rules;
+	/// Buffers for the rule index that are reused by all lookups.
+	std::vector<size_t> m_candidates;
+	std::vector<Expression const*> m_pendingExpressions;
 };
 
 /**
@@ -101,6 +105,8 @@ public:
 	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
+	/// @returns the shape of this pattern for SimplificationRuleIndex.
+	PatternShape shape() const;
 
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
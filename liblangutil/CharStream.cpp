@@ -53,6 +53,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace langutil;
 
@@ -84,14 +86,9 @@ string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
 	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
+	size_type searchEnd = max<size_type>(min<size_type>(m_source.size(), _position), 1);
+	auto starts = lineStarts();
+	size_type lineStart = *prev(upper_bound(starts->begin(), starts->end(), searchEnd));
 	return m_source.substr(
 		lineStart,
 		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
@@ -102,14 +99,23 @@ tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
 	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	auto starts = lineStarts();
+	auto line = prev(upper_bound(starts->begin(), starts->end(), searchPosition));
+	return tuple<int, int>(line - starts->begin(), searchPosition - *line);
+}
+
+shared_ptr<vector<size_t> const> CharStream::lineStarts() const
+{
+	auto starts = atomic_load(&m_lineStarts);
+	if (!starts)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		auto newStarts = make_shared<vector<size_t>>(1, 0);
+		for (size_t i = 0; i < m_source.size(); ++i)
+			if (m_source[i] == '\n')
+				newStarts->push_back(i + 1);
+		// Threads racing here compute the same table, so it does not matter which one wins.
+		starts = move(newStarts);
+		atomic_store(&m_lineStarts, starts);
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return starts;
 }
@@ -53,8 +53,10 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace langutil
 {
@@ -91,16 +93,22 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors and source locations.
+	/// The first call scans the whole source, further calls only do a binary search.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
+	/// @returns the offsets at which lines start, computing them on the first call.
+	std::shared_ptr<std::vector<size_t> const> lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Start offset of every line, sorted. Only accessed atomically, since the stream
+	/// can be used by several threads to translate locations.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
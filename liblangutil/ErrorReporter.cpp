@@ -86,6 +86,13 @@ void ErrorReporter::error(Error::Type _type, SourceLocation const& _location, Se
 	m_errorList.push_back(err);
 }
 
+void ErrorReporter::report(ErrorList const& _errorList)
+{
+	for (auto const& error: _errorList)
+		if (!checkForExcessiveErrors(error->type()))
+			m_errorList.push_back(error);
+}
+
 bool ErrorReporter::hasExcessiveErrors() const
 {
 	return m_errorCount > c_maxErrorsAllowed;
@@ -143,6 +150,8 @@ ErrorList const& ErrorReporter::errors() const
 void ErrorReporter::clear()
 {
 	m_errorList.clear();
+	m_errorCount = 0;
+	m_warningCount = 0;
 }
 
 void ErrorReporter::declarationError(SourceLocation const& _location, SecondarySourceLocation const& _secondaryLocation, string const& _description)
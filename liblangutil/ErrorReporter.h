@@ -50,6 +50,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Adds the errors in @a _errorList as if they were reported through this reporter one after
+	/// the other, i.e. subject to the limits on the number of errors and warnings.
+	/// Throws FatalError if there are too many errors.
+	void report(ErrorList const& _errorList);
+
 	void warning(std::string const& _description);
 
 	void warning(SourceLocation const& _location, std::string const& _description);
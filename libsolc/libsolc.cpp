@@ -27,6 +27,7 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/JSON.h>
 
+#include <new>
 #include <string>
 
 #include "license.h"
@@ -83,6 +84,11 @@ string compile(string _input, CStyleReadFileCallback _readCallback = nullptr)
 
 static string s_outputBuffer;
 
+struct solidity_context
+{
+	string output;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -106,4 +112,26 @@ extern void solidity_free() noexcept
 	yul::YulStringRepository::reset();
 	s_outputBuffer.clear();
 }
+extern solidity_context* solidity_context_create() noexcept
+{
+	return new (nothrow) solidity_context{};
+}
+extern char const* solidity_context_compile(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback
+) noexcept
+{
+	// The standard compiler isolates the global state of the compiler from other compilations.
+	_context->output = compile(_input, _readCallback);
+	return _context->output.c_str();
+}
+extern char const* solidity_context_output(solidity_context const* _context) noexcept
+{
+	return _context->output.c_str();
+}
+extern void solidity_context_destroy(solidity_context* _context) noexcept
+{
+	delete _context;
+}
 }
@@ -56,10 +56,39 @@ char const* solidity_version() SOLC_NOEXCEPT;
 char const* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback) SOLC_NOEXCEPT;
 
 /// Frees up any allocated memory.
+/// Waits for compilations that are running in other threads.
 ///
 /// NOTE: the pointer returned by solidity_compile is invalid after calling this!
 void solidity_free() SOLC_NOEXCEPT;
 
+/// Compiler context that owns the output of its last compilation.
+/// Different contexts can be used by different threads concurrently, but a single context
+/// must not be used by several threads at the same time.
+typedef struct solidity_context solidity_context;
+
+/// Creates a new compiler context, which has to be destroyed using solidity_context_destroy.
+/// Returns null if it could not be allocated.
+solidity_context* solidity_context_create() SOLC_NOEXCEPT;
+
+/// Takes a "Standard Input JSON" and an optional callback (can be set to null) and compiles
+/// it in the given context. The callback is only called from the calling thread.
+/// Returns a "Standard Output JSON". Both are to be UTF-8 encoded.
+///
+/// The pointer returned must not be freed by the caller. It is valid until the next compilation
+/// in the same context or until the context is destroyed.
+char const* solidity_context_compile(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback
+) SOLC_NOEXCEPT;
+
+/// Returns the output of the last compilation in the given context or an empty string if
+/// nothing was compiled yet. The same rules as for the result of solidity_context_compile apply.
+char const* solidity_context_output(solidity_context const* _context) SOLC_NOEXCEPT;
+
+/// Destroys the given context and frees the memory of its output.
+void solidity_context_destroy(solidity_context* _context) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,17 +38,65 @@ using namespace dev::solidity;
 class IDDispenser
 {
 public:
-	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static size_t next() { return ++counter(); }
+	static void reset() { counter() = 0; }
+	static size_t reserve(size_t _count)
+	{
+		size_t& id = counter();
+		id += _count;
+		return id - _count;
+	}
+	/// Counter of the innermost local ID scope of the current thread, if any.
+	static size_t*& localCounter()
+	{
+		static thread_local size_t* counter = nullptr;
+		return counter;
+	}
 private:
-	static size_t& instance()
+	static IDDispenser& instance()
 	{
 		static IDDispenser dispenser;
-		return dispenser.id;
+		return dispenser;
+	}
+	static size_t& counter()
+	{
+		size_t* local = localCounter();
+		return local ? *local : instance().id;
 	}
 	size_t id = 0;
 };
 
+namespace
+{
+
+/// Collects all nodes of a tree, including the identifiers of import aliases.
+class NodeCollector: public ASTVisitor
+{
+public:
+	explicit NodeCollector(ASTNode& _root) { _root.accept(*this); }
+	set<ASTNode*> const& nodes() const { return m_nodes; }
+
+	bool visit(ImportDirective& _import) override
+	{
+		for (auto const& alias: _import.symbolAliases())
+			m_nodes.insert(alias.first.get());
+		return visitNode(_import);
+	}
+
+protected:
+	bool visitNode(ASTNode& _node) override
+	{
+		m_nodes.insert(&_node);
+		return true;
+	}
+
+private:
+	/// A set because nodes might be reachable through several parents.
+	set<ASTNode*> m_nodes;
+};
+
+}
+
 ASTNode::ASTNode(SourceLocation const& _location):
 	m_id(IDDispenser::next()),
 	m_location(_location)
@@ -65,6 +113,29 @@ void ASTNode::resetID()
 	IDDispenser::reset();
 }
 
+ASTNode::LocalIDScope::LocalIDScope():
+	m_outerCounter(IDDispenser::localCounter())
+{
+	IDDispenser::localCounter() = &m_count;
+}
+
+ASTNode::LocalIDScope::~LocalIDScope()
+{
+	IDDispenser::localCounter() = m_outerCounter;
+}
+
+size_t ASTNode::reserveIDs(size_t _count)
+{
+	return IDDispenser::reserve(_count);
+}
+
+void ASTNode::shiftIDs(ASTNode& _root, size_t _offset)
+{
+	NodeCollector collector(_root);
+	for (ASTNode* node: collector.nodes())
+		node->m_id += _offset;
+}
+
 ASTAnnotation& ASTNode::annotation() const
 {
 	if (!m_annotation)
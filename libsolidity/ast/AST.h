@@ -70,9 +70,35 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
+	/// Resets the ID counter of the current thread (see LocalIDScope) or the global ID counter.
+	/// This invalidates all previous IDs.
 	static void resetID();
 
+	/**
+	 * While an instance exists, the nodes created by the current thread take consecutive IDs
+	 * starting at one from a counter of their own instead of the global counter. resetID and
+	 * reserveIDs also act on this counter.
+	 * This allows independent compilations to run concurrently and creating the trees of one
+	 * compilation concurrently, whose IDs have to be made unique using reserveIDs and shiftIDs
+	 * afterwards.
+	 */
+	class LocalIDScope: private boost::noncopyable
+	{
+	public:
+		LocalIDScope();
+		~LocalIDScope();
+		/// @returns the number of IDs handed out inside this scope so far.
+		size_t count() const { return m_count; }
+	private:
+		size_t m_count = 0;
+		size_t* m_outerCounter = nullptr;
+	};
+	/// Takes @a _count IDs from the counter used by resetID.
+	/// @returns the ID before the first of them.
+	static size_t reserveIDs(size_t _count);
+	/// Adds @a _offset to the IDs of @a _root and of all nodes below it.
+	static void shiftIDs(ASTNode& _root, size_t _offset);
+
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
 	template <class T>
@@ -106,7 +132,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
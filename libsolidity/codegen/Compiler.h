@@ -35,19 +35,36 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings):
+	/// @param _yulFunctionCache if not null, generated Yul helper functions are shared through it
+	/// with other contracts of the same compilation.
+	explicit Compiler(
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<YulFunctionCache> _yulFunctionCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion),
-		m_context(_evmVersion, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, nullptr, _yulFunctionCache),
+		m_context(_evmVersion, &m_runtimeContext, _yulFunctionCache)
 	{ }
 
-	/// Compiles a contract.
+	/// Compiles a contract and optimises the resulting assembly.
 	/// @arg _metadata contains the to be injected metadata CBOR
 	void compileContract(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Generates the unoptimised assembly for a contract. This is the part of @a compileContract
+	/// that accesses the AST and the type system.
+	/// @arg _metadata contains the to be injected metadata CBOR
+	void generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
+	);
+	/// Runs the assembly optimiser on the code generated by @a generateCode.
+	/// Only operates on the assembly of this compiler and its sub-assemblies.
+	void optimise() { m_context.optimise(m_optimiserSettings); }
 	/// @returns Entire assembly.
 	eth::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
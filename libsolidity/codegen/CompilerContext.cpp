@@ -432,7 +432,9 @@ void CompilerContext::appendInlineAssembly(
 			&meter,
 			obj,
 			_optimiserSettings.optimizeStackAllocation,
-			externallyUsedIdentifiers
+			externallyUsedIdentifiers,
+			_optimiserSettings.workerThreads,
+			_optimiserSettings.yulOptimiserProfile.get()
 		);
 		analysisInfo = std::move(*obj.analysisInfo);
 		parserResult = std::move(obj.code);
@@ -497,7 +499,7 @@ void CompilerContext::updateSourceLocation()
 eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0, 1};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -506,6 +508,7 @@ eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(Opt
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
+	asmSettings.threads = _settings.workerThreads;
 	return asmSettings;
 }
 
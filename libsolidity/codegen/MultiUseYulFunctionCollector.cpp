@@ -23,6 +23,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libdevcore/Common.h>
+
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -36,17 +38,101 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 	for (auto const& f: m_requestedFunctions)
 		result += f.second;
 	m_requestedFunctions.clear();
+	m_sharedFunctions.clear();
+	return result;
+}
+
+vector<MultiUseYulFunctionCollector::RequestedFunction> MultiUseYulFunctionCollector::requestedFunctionList()
+{
+	vector<RequestedFunction> result;
+	for (auto& f: m_requestedFunctions)
+		result.push_back({f.first, move(f.second), m_sharedFunctions.count(f.first) > 0});
+	m_requestedFunctions.clear();
+	m_sharedFunctions.clear();
 	return result;
 }
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
+	return create(_name, _creator, true);
+}
+
+string MultiUseYulFunctionCollector::createContractSpecificFunction(string const& _name, function<string ()> const& _creator)
+{
+	return create(_name, _creator, false);
+}
+
+string MultiUseYulFunctionCollector::create(string const& _name, function<string ()> const& _creator, bool _shared)
+{
+	if (!m_creationStack.empty() && m_creationStack.back())
+		m_creationStack.back()->push_back(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+
+	if (_shared && m_cache)
+		if (auto entry = m_cache->find(_name))
+		{
+			addFromCache(_name, *entry);
+			return _name;
+		}
+
+	vector<string> dependencies;
+	m_creationStack.push_back(_shared ? &dependencies : nullptr);
+	ScopeGuard popCreationStack([&]() { m_creationStack.pop_back(); });
+	string fun = _creator();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
+	if (_shared && m_cache)
 	{
-		string fun = _creator();
-		solAssert(!fun.empty(), "");
-		solAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
-		m_requestedFunctions[_name] = std::move(fun);
+		m_cache->insert(_name, make_shared<YulFunctionCache::Entry const>(YulFunctionCache::Entry{fun, move(dependencies)}));
+		m_sharedFunctions.insert(_name);
 	}
+	m_requestedFunctions[_name] = std::move(fun);
 	return _name;
 }
+
+void MultiUseYulFunctionCollector::addFromCache(string const& _name, YulFunctionCache::Entry const& _entry)
+{
+	m_requestedFunctions[_name] = _entry.code;
+	m_sharedFunctions.insert(_name);
+	for (string const& dependency: _entry.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			auto entry = m_cache->find(dependency);
+			solAssert(entry, "Dependency " + dependency + " of shared Yul function " + _name + " not found.");
+			addFromCache(dependency, *entry);
+		}
+}
+
+shared_ptr<YulFunctionCache::Entry const> YulFunctionCache::find(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_name);
+	return it == m_entries.end() ? nullptr : it->second;
+}
+
+void YulFunctionCache::insert(string const& _name, shared_ptr<Entry const> _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(_name, move(_entry));
+}
+
+shared_ptr<yul::Block const> YulFunctionCache::parsedFunction(
+	string const& _name,
+	function<shared_ptr<yul::Block const>(string const&)> const& _parse
+)
+{
+	shared_ptr<Entry const> entry;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_parsedFunctions.find(_name);
+		if (it != m_parsedFunctions.end())
+			return it->second;
+		entry = m_entries.at(_name);
+	}
+	// Parses without holding the lock. If another thread parses the same function
+	// in the meantime, its result is used.
+	shared_ptr<yul::Block const> parsed = _parse(entry->code);
+	lock_guard<mutex> lock(m_mutex);
+	return m_parsedFunctions.emplace(_name, move(parsed)).first->second;
+}
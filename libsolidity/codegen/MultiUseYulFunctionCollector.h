@@ -23,13 +23,59 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace yul
+{
+struct Block;
+}
 
 namespace dev
 {
 namespace solidity
 {
 
+/**
+ * Code of Yul functions that is shared between the function collectors of all contracts
+ * of one compilation, so that helper functions are generated only once per compilation.
+ * Only functions whose code is completely determined by their name (for the EVM version
+ * of the compilation) may be stored here, like those of ABIFunctions and YulUtilFunctions.
+ * Can be used from several threads concurrently.
+ */
+class YulFunctionCache
+{
+public:
+	struct Entry
+	{
+		std::string code;
+		/// Names of the functions the creator of this function requested, which have to be
+		/// present whenever this function is.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the entry for the function @a _name or nullptr if there is none.
+	std::shared_ptr<Entry const> find(std::string const& _name) const;
+	/// Stores @a _entry unless there already is an entry for @a _name.
+	void insert(std::string const& _name, std::shared_ptr<Entry const> _entry);
+	/// @returns the code of the function @a _name, which has to be in the cache, as parsed
+	/// by @a _parse. Every function is only parsed once per cache, so @a _parse has to give
+	/// the same result for every call. The result is shared and must not be modified.
+	std::shared_ptr<yul::Block const> parsedFunction(
+		std::string const& _name,
+		std::function<std::shared_ptr<yul::Block const>(std::string const&)> const& _parse
+	);
+
+private:
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, std::shared_ptr<Entry const>> m_entries;
+	std::unordered_map<std::string, std::shared_ptr<yul::Block const>> m_parsedFunctions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,19 +83,50 @@ namespace solidity
 class MultiUseYulFunctionCollector
 {
 public:
+	/// Creates a collector that takes the code of functions from @a _cache and stores newly
+	/// created functions there, unless it is null.
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<YulFunctionCache> _cache = nullptr):
+		m_cache(std::move(_cache))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
-	/// cases.
+	/// cases. The code is taken from or stored in the shared cache, so it has to be
+	/// determined by @a _name alone.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	/// Like createFunction, but for functions whose code depends on the contract they are
+	/// generated for. These are never shared with other contracts.
+	std::string createContractSpecificFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	struct RequestedFunction
+	{
+		std::string name;
+		std::string code;
+		/// True if the function is stored in the cache.
+		bool shared;
+	};
 
 	/// @returns concatenation of all generated functions.
 	/// Clears the internal list, i.e. calling it again will result in an
 	/// empty return value.
 	std::string requestedFunctions();
+	/// @returns all generated functions, in the order in which requestedFunctions concatenates
+	/// them. Clears the internal list like requestedFunctions.
+	std::vector<RequestedFunction> requestedFunctionList();
 
 private:
+	std::string create(std::string const& _name, std::function<std::string()> const& _creator, bool _shared);
+	/// Adds the function @a _name and all its dependencies from the cache.
+	void addFromCache(std::string const& _name, YulFunctionCache::Entry const& _entry);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	/// Names of the requested functions that are stored in the cache.
+	std::set<std::string> m_sharedFunctions;
+	std::shared_ptr<YulFunctionCache> m_cache;
+	/// Dependencies of the shared functions that are currently being created, null for
+	/// contract-specific functions.
+	std::vector<std::vector<std::string>*> m_creationStack;
 };
 
 }
@@ -29,8 +29,12 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
+#include <libyul/AsmParser.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/ObjectParser.h>
 #include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libdevcore/CommonData.h>
 #include <libdevcore/Whiskers.h>
@@ -44,18 +48,15 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
-pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
+shared_ptr<yul::Object> IRGenerator::run(ContractDefinition const& _contract, string* o_ir, string* o_irOptimized)
 {
-	string const ir = yul::reindent(generate(_contract));
+	// The generated code is only reindented if it is requested as text, the parser does not need it.
+	string ir;
+	shared_ptr<yul::Object> object = generate(_contract, o_ir ? &ir : nullptr);
 
 	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
-	{
-		string errorMessage;
-		for (auto const& error: asmStack.errors())
-			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
-		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
-	}
+	if (!asmStack.analyze(object))
+		reportInvalidIR(ir.empty() ? object->toString(false) : ir, asmStack.errors());
 	asmStack.optimize();
 
 	string warning =
@@ -66,10 +67,14 @@ pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
 		" *                !USE AT YOUR OWN RISK!               *\n"
 		" *******************************************************/\n\n";
 
-	return {warning + ir, warning + asmStack.print()};
+	if (o_ir)
+		*o_ir = warning + yul::reindent(ir);
+	if (o_irOptimized)
+		*o_irOptimized = warning + asmStack.print();
+	return asmStack.parserResult();
 }
 
-string IRGenerator::generate(ContractDefinition const& _contract)
+shared_ptr<yul::Object> IRGenerator::generate(ContractDefinition const& _contract, string* o_ir)
 {
 	solUnimplementedAssert(!_contract.isLibrary(), "Libraries not yet implemented.");
 
@@ -103,7 +108,7 @@ string IRGenerator::generate(ContractDefinition const& _contract)
 	for (auto const* contract: _contract.annotation().linearizedBaseContracts)
 		for (auto const* fun: contract->definedFunctions())
 			generateFunction(*fun);
-	t("functions", m_context.functionCollector()->requestedFunctions());
+	auto functions = m_context.functionCollector()->requestedFunctionList();
 
 	resetContext(_contract);
 	m_context.setInheritanceHierarchy(_contract.annotation().linearizedBaseContracts);
@@ -112,8 +117,101 @@ string IRGenerator::generate(ContractDefinition const& _contract)
 	for (auto const* contract: _contract.annotation().linearizedBaseContracts)
 		for (auto const* fun: contract->definedFunctions())
 			generateFunction(*fun);
-	t("runtimeFunctions", m_context.functionCollector()->requestedFunctions());
-	return t.render();
+	auto runtimeFunctions = m_context.functionCollector()->requestedFunctionList();
+
+	if (o_ir)
+	{
+		auto concatenate = [](vector<MultiUseYulFunctionCollector::RequestedFunction> const& _functions)
+		{
+			string code;
+			for (auto const& function: _functions)
+				code += function.code;
+			return code;
+		};
+		Whiskers text = t;
+		text("functions", concatenate(functions));
+		text("runtimeFunctions", concatenate(runtimeFunctions));
+		*o_ir = text.render();
+	}
+
+	// The functions are added to the parsed objects, so that the shared helper functions are
+	// parsed only once per compilation.
+	t("functions", "");
+	t("runtimeFunctions", "");
+	string const code = t.render();
+	langutil::ErrorList errors;
+	langutil::ErrorReporter errorReporter(errors);
+	shared_ptr<yul::Object> object = yul::ObjectParser(errorReporter, dialect()).parse(
+		make_shared<langutil::Scanner>(langutil::CharStream(code, "")),
+		false
+	);
+	if (!object || !errors.empty())
+		reportInvalidIR(code, errors);
+	solAssert(object->subObjects.size() == 1, "");
+	auto runtimeObject = dynamic_pointer_cast<yul::Object>(object->subObjects.front());
+	solAssert(runtimeObject, "");
+	appendFunctions(*object->code, functions);
+	appendFunctions(*runtimeObject->code, runtimeFunctions);
+	return object;
+}
+
+void IRGenerator::appendFunctions(
+	yul::Block& _block,
+	vector<MultiUseYulFunctionCollector::RequestedFunction> const& _functions
+)
+{
+	// Consecutive contract-specific functions are parsed together, the shared functions are copied.
+	string code;
+	yul::ASTCopier copier;
+	auto append = [&](yul::Block const& _functions)
+	{
+		for (auto const& statement: _functions.statements)
+			_block.statements.emplace_back(copier.translate(statement));
+	};
+	auto appendCode = [&]()
+	{
+		if (!code.empty())
+			append(*parseFunctions(code));
+		code.clear();
+	};
+	for (auto const& function: _functions)
+		if (function.shared)
+		{
+			appendCode();
+			append(*m_yulFunctionCache->parsedFunction(function.name, [&](string const& _code) {
+				return parseFunctions(_code);
+			}));
+		}
+		else
+			code += function.code;
+	appendCode();
+}
+
+shared_ptr<yul::Block const> IRGenerator::parseFunctions(string const& _code) const
+{
+	string const block = "{" + _code + "}";
+	langutil::ErrorList errors;
+	langutil::ErrorReporter errorReporter(errors);
+	shared_ptr<yul::Block> parsed = yul::Parser(errorReporter, dialect()).parse(
+		make_shared<langutil::Scanner>(langutil::CharStream(block, "")),
+		false
+	);
+	if (!parsed || !errors.empty())
+		reportInvalidIR(block, errors);
+	return parsed;
+}
+
+void IRGenerator::reportInvalidIR(string const& _code, langutil::ErrorList const& _errors)
+{
+	string errorMessage;
+	for (auto const& error: _errors)
+		errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
+	solAssert(false, _code + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+}
+
+yul::Dialect const& IRGenerator::dialect() const
+{
+	return yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion);
 }
 
 string IRGenerator::generate(Block const& _block)
@@ -126,7 +224,7 @@ string IRGenerator::generate(Block const& _block)
 string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
 	string functionName = m_context.functionName(_function);
-	return m_context.functionCollector()->createFunction(functionName, [&]() {
+	return m_context.functionCollector()->createContractSpecificFunction(functionName, [&]() {
 		Whiskers t(R"(
 			function <functionName>(<params>) <returns> {
 				for { let return_flag := 1 } return_flag {} {
@@ -160,7 +258,7 @@ string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 
 	solUnimplementedAssert(type->isValueType(), "");
 
-	return m_context.functionCollector()->createFunction(functionName, [&]() {
+	return m_context.functionCollector()->createContractSpecificFunction(functionName, [&]() {
 		pair<u256, unsigned> slot_offset = m_context.storageLocationOfVariable(_varDecl);
 
 		return Whiskers(R"(
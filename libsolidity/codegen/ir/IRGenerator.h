@@ -27,7 +27,17 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/Exceptions.h>
+#include <memory>
 #include <string>
+#include <vector>
+
+namespace yul
+{
+struct Block;
+struct Dialect;
+struct Object;
+}
 
 namespace dev
 {
@@ -39,21 +49,43 @@ class SourceUnit;
 class IRGenerator
 {
 public:
-	IRGenerator(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings):
+	IRGenerator(
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<YulFunctionCache> _yulFunctionCache = nullptr
+	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
-		m_context(_evmVersion, std::move(_optimiserSettings)),
+		m_yulFunctionCache(_yulFunctionCache),
+		m_context(_evmVersion, std::move(_optimiserSettings), std::move(_yulFunctionCache)),
 		m_utils(_evmVersion, m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(ContractDefinition const& _contract);
+	/// Generates the IR code and optimizes it, depending on the optimizer settings.
+	/// If @a o_ir or @a o_irOptimized are given, the unoptimized IR and the optimized
+	/// (or just pretty-printed) IR are stored there as text.
+	/// @returns the analyzed Yul object of the optimized code.
+	std::shared_ptr<yul::Object> run(
+		ContractDefinition const& _contract,
+		std::string* o_ir = nullptr,
+		std::string* o_irOptimized = nullptr
+	);
 
 private:
-	std::string generate(ContractDefinition const& _contract);
+	/// Generates the Yul object of @a _contract, which is parsed but not analyzed yet.
+	/// If @a o_ir is given, the generated code is also stored there as text.
+	std::shared_ptr<yul::Object> generate(ContractDefinition const& _contract, std::string* o_ir);
 	std::string generate(Block const& _block);
 
+	/// Appends the definitions of @a _functions to @a _block. The functions that are stored in
+	/// the cache are parsed once and then copied.
+	void appendFunctions(yul::Block& _block, std::vector<MultiUseYulFunctionCollector::RequestedFunction> const& _functions);
+	/// @returns the parsed definitions of the functions in @a _code.
+	std::shared_ptr<yul::Block const> parseFunctions(std::string const& _code) const;
+	/// Fails with the errors @a _errors of the generated code @a _code.
+	static void reportInvalidIR(std::string const& _code, langutil::ErrorList const& _errors);
+	yul::Dialect const& dialect() const;
+
 	/// Generates code for and returns the name of the function.
 	std::string generateFunction(FunctionDefinition const& _function);
 	/// Generates a getter for the given declaration and returns its name
@@ -74,6 +106,7 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	std::shared_ptr<YulFunctionCache> const m_yulFunctionCache;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
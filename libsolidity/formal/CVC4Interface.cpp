@@ -20,6 +20,8 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
@@ -84,7 +86,22 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	vector<string> values;
 	try
 	{
-		switch (m_solver.checkSat().isSat())
+		CVC4::Result checkResult;
+		{
+			{
+				lock_guard<mutex> lock(m_interruptMutex);
+				if (m_interrupted)
+					return make_pair(CheckResult::UNKNOWN, values);
+				m_checking = true;
+			}
+			ScopeGuard checkEnd([&]()
+			{
+				lock_guard<mutex> lock(m_interruptMutex);
+				m_checking = false;
+			});
+			checkResult = m_solver.checkSat();
+		}
+		switch (checkResult.isSat())
 		{
 		case CVC4::Result::SAT:
 			result = CheckResult::SATISFIABLE;
@@ -114,6 +131,26 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	lock_guard<mutex> lock(m_interruptMutex);
+	m_interrupted = true;
+	if (m_checking)
+		m_solver.interrupt();
+}
+
+void CVC4Interface::clearInterrupt()
+{
+	lock_guard<mutex> lock(m_interruptMutex);
+	solAssert(!m_checking, "");
+	m_interrupted = false;
+}
+
+string CVC4Interface::identity() const
+{
+	return "cvc4-" + CVC4::Configuration::getVersionString();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
@@ -20,6 +20,8 @@
 #include <libsolidity/formal/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 
+#include <mutex>
+
 #if defined(__GLIBC__)
 // The CVC4 headers includes the deprecated system headers <ext/hash_map>
 // and <ext/hash_set>. These headers cause a warning that will break the
@@ -54,6 +56,9 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	void clearInterrupt() override;
+	std::string identity() const override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
@@ -63,6 +68,13 @@ private:
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+
+	/// Protects m_checking and m_interrupted.
+	std::mutex m_interruptMutex;
+	/// True while CVC4 works on a query.
+	bool m_checking = false;
+	/// True if interrupt was called since the last call to clearInterrupt.
+	bool m_interrupted = false;
 };
 
 }
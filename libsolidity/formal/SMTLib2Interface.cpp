@@ -125,6 +125,40 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+string SMTLib2Interface::normalisedQuery(vector<Expression> const& _expressionsToEvaluate)
+{
+	string query = boost::algorithm::join(m_accumulatedOutput, "\n") + checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	map<string, string> names;
+	string normalised;
+	normalised.reserve(query.size());
+	for (size_t position = 0; position < query.size();)
+	{
+		size_t end = query.find_first_of("() \t\n", position);
+		if (end == position)
+		{
+			normalised += query[position++];
+			continue;
+		}
+		if (end == string::npos)
+			end = query.size();
+		string token = query.substr(position, end - position);
+		position = end;
+
+		// Declarations quote the names, uses do not.
+		bool quoted = token.size() >= 2 && token.front() == '|' && token.back() == '|';
+		string name = quoted ? token.substr(1, token.size() - 2) : token;
+		if (m_variables.count(name))
+		{
+			auto it = names.find(name);
+			if (it == names.end())
+				it = names.emplace(name, "v" + to_string(names.size())).first;
+			token = quoted ? "|" + it->second + "|" : it->second;
+		}
+		normalised += token;
+	}
+	return normalised;
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
 	if (_expr.arguments.empty())
@@ -54,6 +54,13 @@ public:
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
+	std::string identity() const override { return "smtlib2"; }
+
+	/// @returns the query check would send for @a _expressionsToEvaluate with the declared
+	/// names replaced by names that only depend on the order of their first use. This way
+	/// the query does not change if only unrelated parts of the source (and thus the AST IDs
+	/// in the names) change.
+	std::string normalisedQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
 private:
 	void declareFunction(std::string const&, Sort const&);
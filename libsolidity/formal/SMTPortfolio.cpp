@@ -24,15 +24,24 @@
 #include <libsolidity/formal/CVC4Interface.h>
 #endif
 #include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses)
+SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses, PortfolioSettings _settings):
+	m_settings(_settings)
 {
-	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses));
+	auto smtlib2 = make_unique<smt::SMTLib2Interface>(_smtlib2Responses);
+	m_smtlib2 = smtlib2.get();
+	m_solvers.emplace_back(move(smtlib2));
 #ifdef HAVE_Z3
 	m_solvers.emplace_back(make_unique<smt::Z3Interface>());
 #endif
@@ -100,32 +109,58 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers race (see PortfolioSettings), the first answer is returned and the other
+ * solvers are interrupted, so conflicts are only detected between solvers that finish
+ * at about the same time. With a query timeout, solvers that did not finish in time
+ * count as UNKNOWN.
+ *
+ * If there is a query cache, it is keyed by the normalised SMT-LIB2 form of the query and
+ * the identities of the solvers. Only SAT and UNSAT are cached, since the other results
+ * might be different next time.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	if (!m_settings.cache)
+		return solve(_expressionsToEvaluate);
+
+	h256 key = SMTQueryCache::key(identity(), m_smtlib2->normalisedQuery(_expressionsToEvaluate));
+	if (auto cached = m_settings.cache->load(key))
+		return *cached;
+	auto result = solve(_expressionsToEvaluate);
+	if (solverAnswered(result.first))
+		m_settings.cache->store(key, result);
+	return result;
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::solve(vector<Expression> const& _expressionsToEvaluate)
+{
+	Deadline deadline;
+	if (m_settings.queryTimeout > 0)
+		deadline = chrono::steady_clock::now() + chrono::milliseconds(m_settings.queryTimeout);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	if (m_settings.race)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		vector<SolverInterface*> solvers;
+		for (auto const& s: m_solvers)
+			solvers.push_back(s.get());
+		for (auto& result: checkConcurrently(solvers, _expressionsToEvaluate, deadline, true))
+			if (!mergeResult(move(result), lastResult, finalValues))
+				break;
+	}
+	else
+		for (auto const& s: m_solvers)
 		{
-			if (!solverAnswered(lastResult))
-			{
-				lastResult = result;
-				finalValues = std::move(values);
-			}
-			else if (lastResult != result)
-			{
-				lastResult = CheckResult::CONFLICTING;
+			pair<CheckResult, vector<string>> result{CheckResult::UNKNOWN, {}};
+			if (!deadline)
+				result = s->check(_expressionsToEvaluate);
+			else if (chrono::steady_clock::now() < *deadline)
+				result = move(checkConcurrently({s.get()}, _expressionsToEvaluate, deadline, false).front());
+			if (!mergeResult(move(result), lastResult, finalValues))
 				break;
-			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
-	}
 	return make_pair(lastResult, finalValues);
 }
 
@@ -138,7 +173,131 @@ vector<string> SMTPortfolio::unhandledQueries()
 	return m_solvers.front()->unhandledQueries();
 }
 
+string SMTPortfolio::identity() const
+{
+	string identities;
+	for (auto const& s: m_solvers)
+		identities += (identities.empty() ? "" : ",") + s->identity();
+	return identities;
+}
+
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
 }
+
+bool SMTPortfolio::mergeResult(
+	pair<CheckResult, vector<string>> _result,
+	CheckResult& io_result,
+	vector<string>& io_values
+)
+{
+	if (solverAnswered(_result.first))
+	{
+		if (!solverAnswered(io_result))
+		{
+			io_result = _result.first;
+			io_values = move(_result.second);
+		}
+		else if (io_result != _result.first)
+		{
+			io_result = CheckResult::CONFLICTING;
+			return false;
+		}
+	}
+	else if (_result.first == CheckResult::UNKNOWN && io_result == CheckResult::ERROR)
+		io_result = _result.first;
+	return true;
+}
+
+vector<pair<CheckResult, vector<string>>> SMTPortfolio::checkConcurrently(
+	vector<SolverInterface*> const& _solvers,
+	vector<Expression> const& _expressionsToEvaluate,
+	Deadline const& _deadline,
+	bool _stopOnAnswer
+)
+{
+	vector<pair<CheckResult, vector<string>>> results(_solvers.size(), {CheckResult::UNKNOWN, {}});
+	vector<exception_ptr> exceptions(_solvers.size());
+	vector<bool> finished(_solvers.size(), false);
+	size_t finishedCount = 0;
+	bool answered = false;
+	mutex resultsMutex;
+	condition_variable resultAvailable;
+
+	// Interrupts the solvers that are still running and waits until all of them returned.
+	auto interruptAll = [&](unique_lock<mutex>& _lock)
+	{
+		for (size_t i = 0; i < _solvers.size(); ++i)
+			if (!finished[i])
+				_solvers[i]->interrupt();
+		resultAvailable.wait(_lock, [&]() { return finishedCount == _solvers.size(); });
+	};
+	// The interruptions must not affect the next query.
+	auto clearInterrupts = [&]()
+	{
+		for (SolverInterface* solver: _solvers)
+			solver->clearInterrupt();
+	};
+
+	vector<thread> threads;
+	try
+	{
+		for (size_t i = 0; i < _solvers.size(); ++i)
+			threads.emplace_back([&, i]()
+			{
+				pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+				exception_ptr exception;
+				try
+				{
+					result = _solvers[i]->check(_expressionsToEvaluate);
+				}
+				catch (...)
+				{
+					exception = current_exception();
+				}
+				lock_guard<mutex> lock(resultsMutex);
+				answered = answered || solverAnswered(result.first);
+				results[i] = move(result);
+				exceptions[i] = exception;
+				finished[i] = true;
+				++finishedCount;
+				resultAvailable.notify_all();
+			});
+	}
+	catch (...)
+	{
+		{
+			unique_lock<mutex> lock(resultsMutex);
+			// Threads that could not be started will never finish.
+			for (size_t i = threads.size(); i < _solvers.size(); ++i)
+			{
+				finished[i] = true;
+				++finishedCount;
+			}
+			interruptAll(lock);
+		}
+		for (auto& t: threads)
+			t.join();
+		clearInterrupts();
+		throw;
+	}
+
+	{
+		unique_lock<mutex> lock(resultsMutex);
+		auto done = [&]() { return finishedCount == _solvers.size() || (_stopOnAnswer && answered); };
+		if (_deadline)
+			resultAvailable.wait_until(lock, *_deadline, done);
+		else
+			resultAvailable.wait(lock, done);
+		interruptAll(lock);
+	}
+	for (auto& t: threads)
+		t.join();
+	clearInterrupts();
+
+	for (auto const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+	return results;
+}
@@ -23,7 +23,11 @@
 #include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <chrono>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -33,6 +37,24 @@ namespace solidity
 namespace smt
 {
 
+class SMTLib2Interface;
+class SMTQueryCache;
+
+struct PortfolioSettings
+{
+	/// If true, the solvers work on a query concurrently and the first definite answer
+	/// (SAT or UNSAT) is returned, interrupting the solvers that are still running.
+	/// Otherwise the solvers are queried one after the other.
+	bool race = false;
+	/// Time in milliseconds a single query may take across all solvers, zero for no limit
+	/// apart from the timeouts of the solvers themselves. Solvers that are still running
+	/// when it expires are interrupted, solvers that did not start yet are skipped.
+	unsigned queryTimeout = 0;
+	/// If set, answers are looked up in this cache before the solvers are queried, and
+	/// definite answers of the solvers are stored in it.
+	std::shared_ptr<SMTQueryCache const> cache;
+};
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
@@ -42,7 +64,7 @@ namespace smt
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
 public:
-	SMTPortfolio(std::map<h256, std::string> const& _smtlib2Responses);
+	SMTPortfolio(std::map<h256, std::string> const& _smtlib2Responses, PortfolioSettings _settings = PortfolioSettings{});
 
 	void reset() override;
 
@@ -57,10 +79,36 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
+	std::string identity() const override;
 private:
+	using Deadline = boost::optional<std::chrono::steady_clock::time_point>;
+
 	static bool solverAnswered(CheckResult result);
+	/// Combines the answer of one solver, @a _result, into the answer of the portfolio.
+	/// @returns false if the answers conflict, in which case the remaining answers do not matter.
+	static bool mergeResult(
+		std::pair<CheckResult, std::vector<std::string>> _result,
+		CheckResult& io_result,
+		std::vector<std::string>& io_values
+	);
+	/// Runs the query on each of @a _solvers in a thread of its own and waits until all of them
+	/// finished, the @a _deadline passed or, if @a _stopOnAnswer is true, one of them answered.
+	/// Solvers that are still running at that point are interrupted.
+	/// @returns the results in the order of @a _solvers.
+	static std::vector<std::pair<CheckResult, std::vector<std::string>>> checkConcurrently(
+		std::vector<SolverInterface*> const& _solvers,
+		std::vector<Expression> const& _expressionsToEvaluate,
+		Deadline const& _deadline,
+		bool _stopOnAnswer
+	);
+
+	/// @returns the answer of the solvers to the current query, without consulting the cache.
+	std::pair<CheckResult, std::vector<std::string>> solve(std::vector<Expression> const& _expressionsToEvaluate);
 
 	std::vector<std::unique_ptr<smt::SolverInterface>> m_solvers;
+	/// The first of m_solvers, which also provides the normalised queries for the cache.
+	SMTLib2Interface* m_smtlib2 = nullptr;
+	PortfolioSettings m_settings;
 
 	std::vector<Expression> m_assertions;
 };
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of SMT query results that is shared between compiler invocations.
+ */
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <liblangutil/Exceptions.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+h256 SMTQueryCache::key(string const& _solvers, string const& _query)
+{
+	return keccak256(_solvers + "\n" + _query);
+}
+
+boost::optional<SMTQueryCache::Result> SMTQueryCache::load(h256 const& _key) const
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it != m_entries.end())
+			return it->second;
+	}
+	if (m_directory.empty())
+		return {};
+
+	string data = readFileAsString(entryPath(_key));
+	Json::Value input;
+	if (data.empty() || !jsonParseStrict(data, input) || !input.isObject() || !input["values"].isArray())
+		return {};
+
+	Result result;
+	if (input["result"] == "sat")
+		result.first = CheckResult::SATISFIABLE;
+	else if (input["result"] == "unsat")
+		result.first = CheckResult::UNSATISFIABLE;
+	else
+		return {};
+	for (Json::Value const& value: input["values"])
+	{
+		if (!value.isString())
+			return {};
+		result.second.emplace_back(value.asString());
+	}
+
+	lock_guard<mutex> lock(m_mutex);
+	remember(_key, result);
+	return result;
+}
+
+void SMTQueryCache::store(h256 const& _key, Result const& _result) const
+{
+	solAssert(
+		_result.first == CheckResult::SATISFIABLE || _result.first == CheckResult::UNSATISFIABLE,
+		"Only definite answers can be cached."
+	);
+	{
+		lock_guard<mutex> lock(m_mutex);
+		remember(_key, _result);
+	}
+	if (m_directory.empty())
+		return;
+
+	Json::Value output{Json::objectValue};
+	output["result"] = _result.first == CheckResult::SATISFIABLE ? "sat" : "unsat";
+	output["values"] = Json::arrayValue;
+	for (string const& value: _result.second)
+		output["values"].append(value);
+	// Failures are ignored, the entry is simply missing next time.
+	writeFileAtomically(entryPath(_key), jsonCompactPrint(output));
+}
+
+string SMTQueryCache::entryPath(h256 const& _key) const
+{
+	return (boost::filesystem::path(m_directory) / (_key.hex() + ".json")).string();
+}
+
+void SMTQueryCache::remember(h256 const& _key, Result const& _result) const
+{
+	if (m_entries.size() >= maxEntries && !m_entries.count(_key))
+		m_entries.clear();
+	m_entries[_key] = _result;
+}
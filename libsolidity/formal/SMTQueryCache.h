@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of SMT query results that is shared between compiler invocations.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Stores the definite answers (SAT or UNSAT, together with the values of the requested
+ * expressions) to SMT queries in memory and, if a directory is given, in that directory,
+ * one file per query. See SMTPortfolio for how the queries are identified.
+ * Files are written atomically, so several processes can share a directory.
+ * The cache is only an optimisation: entries that cannot be read or written are ignored.
+ */
+class SMTQueryCache
+{
+public:
+	using Result = std::pair<CheckResult, std::vector<std::string>>;
+
+	/// Creates a cache that also stores its entries in @a _directory, unless it is empty.
+	/// The directory is created on the first store.
+	explicit SMTQueryCache(std::string _directory = ""): m_directory(std::move(_directory)) {}
+
+	/// @returns the key of the query @a _query answered by the solvers identified by @a _solvers.
+	static h256 key(std::string const& _solvers, std::string const& _query);
+
+	/// @returns the result stored under @a _key or an empty optional if there is none.
+	boost::optional<Result> load(h256 const& _key) const;
+	/// Stores @a _result under @a _key, replacing any previous entry.
+	/// The result has to be SATISFIABLE or UNSATISFIABLE.
+	void store(h256 const& _key, Result const& _result) const;
+
+	std::string const& directory() const { return m_directory; }
+
+private:
+	std::string entryPath(h256 const& _key) const;
+	/// Adds @a _result to the in-memory entries. Requires m_mutex to be locked.
+	void remember(h256 const& _key, Result const& _result) const;
+
+	/// The in-memory entries are cleared when they reach this number, so that long-running
+	/// processes do not accumulate queries. Entries on disk are still found.
+	static size_t constexpr maxEntries = 65536;
+
+	std::string m_directory;
+	mutable std::mutex m_mutex;
+	/// Entries loaded or stored by this instance, protected by m_mutex.
+	mutable std::map<h256, Result> m_entries;
+};
+
+}
+}
+}
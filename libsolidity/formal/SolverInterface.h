@@ -315,12 +315,23 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks the running call to check, or the next one if none is running, to stop as soon
+	/// as possible, in which case it returns UNKNOWN. Can be called from another thread.
+	/// The request stays in effect until clearInterrupt is called, so it does not get lost
+	/// if it arrives while the solver sets up the query.
+	virtual void interrupt() {}
+	/// Withdraws the requests made by interrupt. Must not be called while a query is running.
+	virtual void clearInterrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual unsigned solvers() { return 1; }
 
+	/// @returns the name and version of the solver, which tells apart the answers of different solvers.
+	virtual std::string identity() const = 0;
+
 protected:
 	// SMT query timeout in milliseconds.
 	static int const queryTimeout = 10000;
@@ -27,8 +27,9 @@ using namespace dev::solidity::smt;
 Z3Interface::Z3Interface():
 	m_solver(m_context)
 {
-	// This needs to be set globally.
-	z3::set_param("rewriter.pull_cheap_ite", true);
+	// This needs to be set globally, only once because several checkers can run concurrently.
+	static bool const globalParametersSet = (z3::set_param("rewriter.pull_cheap_ite", true), true);
+	(void)globalParametersSet;
 	// This needs to be set in the context.
 	m_context.set("timeout", queryTimeout);
 }
@@ -79,7 +80,22 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	vector<string> values;
 	try
 	{
-		switch (m_solver.check())
+		z3::check_result checkResult;
+		{
+			{
+				lock_guard<mutex> lock(m_interruptMutex);
+				if (m_interrupted)
+					return make_pair(CheckResult::UNKNOWN, values);
+				m_checking = true;
+			}
+			ScopeGuard checkEnd([&]()
+			{
+				lock_guard<mutex> lock(m_interruptMutex);
+				m_checking = false;
+			});
+			checkResult = m_solver.check();
+		}
+		switch (checkResult)
 		{
 		case z3::check_result::sat:
 			result = CheckResult::SATISFIABLE;
@@ -108,6 +124,44 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	// A query that has not started yet sees the flag. Otherwise Z3 is cancelled, which
+	// also cancels the resource limit of the context that Z3 checks while it solves.
+	// The context only belongs to this solver.
+	lock_guard<mutex> lock(m_interruptMutex);
+	m_interrupted = true;
+	if (m_checking)
+	{
+		Z3_interrupt(m_context);
+		m_cancelled = true;
+	}
+}
+
+void Z3Interface::clearInterrupt()
+{
+	lock_guard<mutex> lock(m_interruptMutex);
+	solAssert(!m_checking, "");
+	m_interrupted = false;
+	if (m_cancelled)
+	{
+		// If Z3 had already finished the query when it was interrupted, the context stays
+		// cancelled and the next push, pop or assertion throws. Starting a query resets it.
+		z3::solver(m_context).check();
+		m_cancelled = false;
+	}
+}
+
+string Z3Interface::identity() const
+{
+	unsigned major;
+	unsigned minor;
+	unsigned build;
+	unsigned revision;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return "z3-" + to_string(major) + "." + to_string(minor) + "." + to_string(build);
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
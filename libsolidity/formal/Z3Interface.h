@@ -21,6 +21,8 @@
 #include <boost/noncopyable.hpp>
 #include <z3++.h>
 
+#include <mutex>
+
 namespace dev
 {
 namespace solidity
@@ -42,6 +44,9 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	void clearInterrupt() override;
+	std::string identity() const override;
 
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
@@ -54,6 +59,15 @@ private:
 	z3::solver m_solver;
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+
+	/// Protects m_checking, m_interrupted and m_cancelled.
+	std::mutex m_interruptMutex;
+	/// True while Z3 works on a query.
+	bool m_checking = false;
+	/// True if interrupt was called since the last call to clearInterrupt.
+	bool m_interrupted = false;
+	/// True if the context was cancelled since the last call to clearInterrupt.
+	bool m_cancelled = false;
 };
 
 }
@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache of compiled contracts that is shared between compiler invocations.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+Json::Value linkerObjectToJson(eth::LinkerObject const& _object)
+{
+	Json::Value output{Json::objectValue};
+	output["object"] = toHex(_object.bytecode);
+	output["linkReferences"] = Json::objectValue;
+	for (auto const& reference: _object.linkReferences)
+		output["linkReferences"][to_string(reference.first)] = reference.second;
+	return output;
+}
+
+bool linkerObjectFromJson(Json::Value const& _input, eth::LinkerObject& o_object)
+{
+	if (!_input.isObject() || !_input["object"].isString() || !_input["linkReferences"].isObject())
+		return false;
+	string const& code = _input["object"].asString();
+	o_object.bytecode = fromHex(code);
+	if (o_object.bytecode.size() * 2 != code.size())
+		return false;
+	for (string const& offset: _input["linkReferences"].getMemberNames())
+	{
+		Json::Value const& library = _input["linkReferences"][offset];
+		if (!library.isString() || offset.empty() || offset.find_first_not_of("0123456789") != string::npos)
+			return false;
+		o_object.linkReferences[stoul(offset)] = library.asString();
+	}
+	return true;
+}
+
+}
+
+boost::optional<CompilationCache::Entry> CompilationCache::load(h256 const& _key) const
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it != m_entries.end())
+			return it->second;
+	}
+	if (m_directory.empty())
+		return {};
+
+	string data = readFileAsString(entryPath(_key));
+	Json::Value input;
+	if (data.empty() || !jsonParseStrict(data, input) || !input.isObject())
+		return {};
+
+	Entry entry;
+	if (
+		!linkerObjectFromJson(input["object"], entry.object) ||
+		!linkerObjectFromJson(input["runtimeObject"], entry.runtimeObject) ||
+		!input["sourceMap"].isString() ||
+		!input["runtimeSourceMap"].isString()
+	)
+		return {};
+	entry.sourceMapping = input["sourceMap"].asString();
+	entry.runtimeSourceMapping = input["runtimeSourceMap"].asString();
+
+	lock_guard<mutex> lock(m_mutex);
+	remember(_key, entry);
+	return entry;
+}
+
+void CompilationCache::store(h256 const& _key, Entry const& _entry) const
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		remember(_key, _entry);
+	}
+	if (m_directory.empty())
+		return;
+
+	Json::Value output{Json::objectValue};
+	output["object"] = linkerObjectToJson(_entry.object);
+	output["runtimeObject"] = linkerObjectToJson(_entry.runtimeObject);
+	output["sourceMap"] = _entry.sourceMapping;
+	output["runtimeSourceMap"] = _entry.runtimeSourceMapping;
+
+	// Failures are ignored, the entry is simply missing next time.
+	writeFileAtomically(entryPath(_key), jsonCompactPrint(output));
+}
+
+string CompilationCache::entryPath(h256 const& _key) const
+{
+	return (boost::filesystem::path(m_directory) / (_key.hex() + ".json")).string();
+}
+
+void CompilationCache::remember(h256 const& _key, Entry const& _entry) const
+{
+	if (m_entries.size() >= maxEntries && !m_entries.count(_key))
+		m_entries.clear();
+	m_entries[_key] = _entry;
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache of compiled contracts that is shared between compiler invocations.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Stores the compilation results of single contracts in memory and, if a directory is given,
+ * in that directory, one file per entry. The in-memory part lets long-running processes reuse
+ * results without touching the disk; it is shared by all users of one instance and its size
+ * is limited.
+ * The key has to identify everything the results depend on, see CompilerStack for how it
+ * is computed. Files are written atomically, so several processes can share a directory.
+ * The cache is only an optimisation: entries that cannot be read or written are ignored.
+ */
+class CompilationCache
+{
+public:
+	struct Entry
+	{
+		eth::LinkerObject object; ///< Unlinked deployment object.
+		eth::LinkerObject runtimeObject; ///< Unlinked runtime object.
+		std::string sourceMapping;
+		std::string runtimeSourceMapping;
+	};
+
+	/// Creates a cache that also stores its entries in @a _directory, unless it is empty.
+	/// The directory is created on the first store.
+	explicit CompilationCache(std::string _directory = ""): m_directory(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key or an empty optional if there is none.
+	boost::optional<Entry> load(h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing any previous entry.
+	void store(h256 const& _key, Entry const& _entry) const;
+
+	std::string const& directory() const { return m_directory; }
+
+private:
+	std::string entryPath(h256 const& _key) const;
+	/// Adds @a _entry to the in-memory entries. Requires m_mutex to be locked.
+	void remember(h256 const& _key, Entry const& _entry) const;
+
+	/// The in-memory entries are cleared when they reach this number, so that long-running
+	/// processes do not accumulate contracts. Entries on disk are still found.
+	static size_t constexpr maxEntries = 1024;
+
+	std::string m_directory;
+	mutable std::mutex m_mutex;
+	/// Entries loaded or stored by this instance, protected by m_mutex.
+	mutable std::map<h256, Entry> m_entries;
+};
+
+}
+}
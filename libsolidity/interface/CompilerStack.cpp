@@ -41,6 +41,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/Version.h>
@@ -55,6 +56,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -64,17 +66,22 @@
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/IpfsHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Parallel.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <deque>
+#include <future>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-static int g_compilerStackCounts = 0;
+// Every thread can use its own TypeProvider, see TypeProvider::Scope.
+static thread_local int g_compilerStackCounts = 0;
 
 CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_readFile{_readFile},
@@ -83,7 +90,7 @@ CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_errorList{},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
+	// Because TypeProvider is currently a singleton API (per thread), we must ensure that
 	// no more than one entity is actually using it at a time.
 	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
@@ -152,6 +159,25 @@ void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 	m_optimiserSettings = std::move(_settings);
 }
 
+void CompilerStack::setWorkerThreads(unsigned _threads)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set worker threads before compiling."));
+	m_workerThreads = max(_threads, 1u);
+}
+
+void CompilerStack::setCacheDirectory(string const& _directory)
+{
+	setCompilationCache(_directory.empty() ? nullptr : make_shared<CompilationCache>(_directory));
+}
+
+void CompilerStack::setCompilationCache(shared_ptr<CompilationCache const> _cache)
+{
+	if (m_stackState >= ParsingSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set compilation cache before parsing."));
+	m_cache = move(_cache);
+}
+
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
 	if (m_stackState >= ParsingSuccessful)
@@ -166,6 +192,13 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 	m_smtlib2Responses[_hash] = _response;
 }
 
+void CompilerStack::setSMTSolverSettings(smt::PortfolioSettings const& _settings)
+{
+	if (m_stackState >= AnalysisSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set SMT solver settings before analysis."));
+	m_smtSolverSettings = _settings;
+}
+
 void CompilerStack::reset(bool _keepSettings)
 {
 	m_stackState = Empty;
@@ -179,10 +212,15 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_generateIR = false;
 		m_generateEWasm = false;
+		m_yulOptimiserProfiling = false;
+		m_workerThreads = 1;
+		m_cache.reset();
+		m_smtSolverSettings = smt::PortfolioSettings{};
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 	}
 	m_globalContext.reset();
+	m_yulFunctionCache.reset();
 	m_scopes.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
@@ -217,26 +255,75 @@ bool CompilerStack::parse()
 			"Do not use it in production unless correctness of generated code is verified with extensive tests."
 		);
 
-	vector<string> sourcesToParse;
+	// Sources are parsed concurrently, but the results are processed in the order in which
+	// the sources were discovered, so that AST IDs, errors and the loaded imports are the
+	// same as with serial parsing. Only this thread calls the read callback.
+	struct ParseJob
+	{
+		string path;
+		ErrorList errors;
+		size_t nodeCount = 0;
+		future<void> done;
+	};
+	deque<ParseJob> jobs;
+	// Without worker threads, the jobs are run as soon as they are added.
+	ThreadPool serialPool(1);
+	ThreadPool& pool = m_workerThreads > 1 ? ThreadPool::shared() : serialPool;
+	// The jobs refer to the sources, so they have to finish even if processing them fails.
+	ScopeGuard waitForJobs([&]() {
+		for (ParseJob& job: jobs)
+			if (job.done.valid())
+				job.done.wait();
+	});
+	auto addJob = [&](string const& _path)
+	{
+		jobs.emplace_back();
+		ParseJob* job = &jobs.back();
+		Source* source = &m_sources[_path];
+		job->path = _path;
+		job->done = pool.addTask([this, job, source]()
+		{
+			ErrorReporter errorReporter(job->errors);
+			ASTNode::LocalIDScope idScope;
+			source->scanner->reset();
+			source->ast = Parser(errorReporter, m_evmVersion, m_parserErrorRecovery).parse(source->scanner);
+			job->nodeCount = idScope.count();
+		});
+	};
+
 	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		addJob(s.first);
+	for (size_t i = 0; i < jobs.size(); ++i)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery).parse(source.scanner);
+		ParseJob& job = jobs[i];
+		job.done.get();
+		Source& source = m_sources[job.path];
+		try
+		{
+			// The errors of all sources count towards the same limit.
+			m_errorReporter.report(job.errors);
+		}
+		catch (FatalError const&)
+		{
+			// The serial parser would have stopped at the error that exceeds the limit.
+			source.ast.reset();
+		}
+		size_t idOffset = ASTNode::reserveIDs(job.nodeCount);
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			// The AST of a source with errors can have missing nodes, even with error recovery,
+			// and is not analysed any further.
+			if (Error::containsOnlyWarnings(job.errors))
+				ASTNode::shiftIDs(*source.ast, idOffset);
+			source.ast->annotation().path = job.path;
+			for (auto const& newSource: loadMissingSources(*source.ast, job.path))
 			{
 				string const& newPath = newSource.first;
 				string const& newContents = newSource.second;
 				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-				sourcesToParse.push_back(newPath);
+				addJob(newPath);
 			}
 		}
 	}
@@ -371,7 +458,7 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses);
+			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_smtSolverSettings);
 			for (Source const* source: m_sourceOrder)
 				modelChecker.analyze(*source->ast, source->scanner);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
@@ -423,6 +510,56 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 	return false;
 }
 
+namespace
+{
+/// Partitions @a _contracts into groups such that contracts in different groups do not share
+/// any direct or indirect contract dependency, i.e. their compilation does not touch the same
+/// assemblies. Contracts keep their relative order inside a group and groups are ordered by
+/// the position of their first contract.
+vector<vector<ContractDefinition const*>> independentContractGroups(
+	vector<ContractDefinition const*> const& _contracts
+)
+{
+	// Union-find over the dependency graph.
+	map<ContractDefinition const*, ContractDefinition const*> parent;
+	function<ContractDefinition const*(ContractDefinition const*)> root =
+		[&](ContractDefinition const* _contract) -> ContractDefinition const*
+		{
+			auto it = parent.find(_contract);
+			if (it == parent.end() || it->second == _contract)
+				return _contract;
+			return it->second = root(it->second);
+		};
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const*)> joinDependencies = [&](ContractDefinition const* _contract)
+	{
+		if (!visited.insert(_contract).second)
+			return;
+		for (ContractDefinition const* dependency: _contract->annotation().contractDependencies)
+		{
+			ContractDefinition const* a = root(_contract);
+			ContractDefinition const* b = root(dependency);
+			if (a != b)
+				parent[b] = a;
+			joinDependencies(dependency);
+		}
+	};
+	for (ContractDefinition const* contract: _contracts)
+		joinDependencies(contract);
+
+	vector<vector<ContractDefinition const*>> groups;
+	map<ContractDefinition const*, size_t> groupIndex;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		auto inserted = groupIndex.insert({root(contract), groups.size()});
+		if (inserted.second)
+			groups.emplace_back();
+		groups[inserted.first->second].push_back(contract);
+	}
+	return groups;
+}
+}
+
 bool CompilerStack::compile()
 {
 	if (m_stackState < AnalysisSuccessful)
@@ -430,18 +567,43 @@ bool CompilerStack::compile()
 			return false;
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<ContractDefinition const*> contracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR || m_generateEWasm)
-						generateIR(*contract);
-					if (m_generateEWasm)
-						generateEWasm(*contract);
-				}
+					contracts.push_back(contract);
+
+	// The Yul optimiser takes the number of threads from the optimiser settings.
+	m_optimiserSettings.workerThreads = m_workerThreads;
+	// The names of the helper functions refer to AST IDs, so they are only shared inside
+	// one compilation.
+	m_yulFunctionCache = make_shared<YulFunctionCache>();
+
+	vector<vector<ContractDefinition const*>> groups;
+	if (m_workerThreads > 1)
+		groups = independentContractGroups(contracts);
+	else
+		groups.emplace_back(move(contracts));
+
+	TypeProvider& typeProvider = TypeProvider::instance();
+	parallelFor(groups.size(), m_workerThreads, [&](size_t _group)
+	{
+		TypeProvider::Scope typeProviderScope(typeProvider);
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: groups[_group])
+		{
+			// Restored contracts have no assembly that their dependents could include, so
+			// compileContract compiles them again if another contract depends on them.
+			if (!otherCompilers.count(contract) && !loadFromCache(*contract))
+				compileContract(*contract, otherCompilers);
+			lock_guard<mutex> lock(m_codeGenerationMutex);
+			if (m_generateIR || m_generateEWasm)
+				generateIR(*contract);
+			if (m_generateEWasm)
+				generateEWasm(*contract);
+		}
+	});
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -566,6 +728,17 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	return contract(_contractName).yulIROptimized;
 }
 
+Json::Value CompilerStack::yulOptimiserProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& currentContract = contract(_contractName);
+	if (!currentContract.yulOptimiserProfile)
+		return Json::Value();
+	return currentContract.yulOptimiserProfile->toJson();
+}
+
 string const& CompilerStack::eWasm(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -946,19 +1119,25 @@ void CompilerStack::compileContract(
 		compileContract(*dependency, _otherCompilers);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	bool restoredFromCache = !compiledContract.object.bytecode.empty();
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, contractOptimiserSettings(compiledContract), m_yulFunctionCache);
 	compiledContract.compiler = compiler;
 
-	bytes cborEncodedMetadata = createCBORMetadata(
-		metadata(compiledContract),
-		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
-	);
+	{
+		lock_guard<mutex> lock(m_codeGenerationMutex);
+		bytes cborEncodedMetadata = createCBORMetadata(
+			metadata(compiledContract),
+			!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
+		);
+		compiler->generateCode(_contract, _otherCompilers, cborEncodedMetadata);
+	}
 
 	try
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		// Run optimiser on the generated assembly. This only touches the assemblies of this
+		// contract and its dependencies and can thus run concurrently for independent contracts.
+		compiler->optimise();
 	}
 	catch(eth::OptimizerException const&)
 	{
@@ -986,6 +1165,91 @@ void CompilerStack::compileContract(
 	}
 
 	_otherCompilers[compiledContract.contract] = compiler;
+
+	// Contracts that are only compiled as dependencies are stored as well, so that they
+	// can be restored when they are requested themselves.
+	if (!restoredFromCache)
+		storeInCache(_contract);
+}
+
+OptimiserSettings CompilerStack::contractOptimiserSettings(Contract& _contract) const
+{
+	OptimiserSettings settings = m_optimiserSettings;
+	if (m_yulOptimiserProfiling)
+	{
+		if (!_contract.yulOptimiserProfile)
+			_contract.yulOptimiserProfile = make_shared<yul::OptimiserProfile>();
+		settings.yulOptimiserProfile = _contract.yulOptimiserProfile;
+	}
+	return settings;
+}
+
+h256 CompilerStack::cacheKey(Contract const& _contract) const
+{
+	Json::Value key{Json::objectValue};
+	key["metadata"] = metadata(_contract);
+	// The CBOR metadata appended to the bytecode depends on the release flag.
+	key["release"] = m_release;
+	// The metadata only lists the optimiser details for non-default settings.
+	key["optimizer"]["orderLiterals"] = m_optimiserSettings.runOrderLiterals;
+	key["optimizer"]["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
+	key["optimizer"]["peephole"] = m_optimiserSettings.runPeephole;
+	key["optimizer"]["deduplicate"] = m_optimiserSettings.runDeduplicate;
+	key["optimizer"]["cse"] = m_optimiserSettings.runCSE;
+	key["optimizer"]["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+	key["optimizer"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+	key["optimizer"]["yul"] = m_optimiserSettings.runYulOptimiser;
+	// Source mappings refer to sources by their index among all sources.
+	map<string, unsigned> indices = sourceIndices();
+	key["sourceIndices"][_contract.contract->sourceUnit().annotation().path] =
+		indices.at(_contract.contract->sourceUnit().annotation().path);
+	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
+		key["sourceIndices"][sourceUnit->annotation().path] = indices.at(sourceUnit->annotation().path);
+	return dev::keccak256(jsonCompactPrint(key));
+}
+
+bool CompilerStack::loadFromCache(ContractDefinition const& _contract)
+{
+	// Restored contracts would not have an optimiser profile.
+	if (!m_cache || m_yulOptimiserProfiling || !_contract.canBeDeployed())
+		return false;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	h256 key;
+	{
+		lock_guard<mutex> lock(m_codeGenerationMutex);
+		key = cacheKey(compiledContract);
+	}
+	boost::optional<CompilationCache::Entry> entry = m_cache->load(key);
+	if (!entry)
+		return false;
+
+	compiledContract.object = move(entry->object);
+	compiledContract.runtimeObject = move(entry->runtimeObject);
+	compiledContract.sourceMapping = make_unique<string const>(move(entry->sourceMapping));
+	compiledContract.runtimeSourceMapping = make_unique<string const>(move(entry->runtimeSourceMapping));
+	return true;
+}
+
+void CompilerStack::storeInCache(ContractDefinition const& _contract)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (!m_cache || !compiledContract.compiler)
+		return;
+
+	CompilationCache::Entry entry;
+	entry.object = compiledContract.object;
+	entry.runtimeObject = compiledContract.runtimeObject;
+	entry.sourceMapping = computeSourceMapping(compiledContract.compiler->assemblyItems());
+	entry.runtimeSourceMapping = computeSourceMapping(compiledContract.compiler->runtimeAssemblyItems());
+	compiledContract.sourceMapping = make_unique<string const>(entry.sourceMapping);
+	compiledContract.runtimeSourceMapping = make_unique<string const>(entry.runtimeSourceMapping);
+	h256 key;
+	{
+		lock_guard<mutex> lock(m_codeGenerationMutex);
+		key = cacheKey(compiledContract);
+	}
+	m_cache->store(key, entry);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -996,38 +1260,38 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	if (!compiledContract.yulIR.empty())
+	if (compiledContract.yulIRObject)
 		return;
 
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
-	IRGenerator generator(m_evmVersion, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
+	// The IR is only printed if it was requested, eWasm generation uses the object directly.
+	IRGenerator generator(m_evmVersion, contractOptimiserSettings(compiledContract), m_yulFunctionCache);
+	compiledContract.yulIRObject = generator.run(
+		_contract,
+		m_generateIR ? &compiledContract.yulIR : nullptr,
+		m_generateIR ? &compiledContract.yulIROptimized : nullptr
+	);
 }
 
 void CompilerStack::generateEWasm(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(compiledContract.yulIRObject, "");
 	if (!compiledContract.eWasm.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack evmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	evmStack.parseAndAnalyze("", compiledContract.yulIROptimized);
-
-	// Turn into eWasm dialect
-	yul::Object ewasmObject = yul::EVMToEWasmTranslator(
+	// Turn the analyzed Yul IR into eWasm dialect
+	auto ewasmObject = make_shared<yul::Object>(yul::EVMToEWasmTranslator(
 		yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion)
-	).run(*evmStack.parserResult());
+	).run(*compiledContract.yulIRObject));
 
-	// Re-inject into an assembly stack for the eWasm dialect
-	yul::AssemblyStack ewasmStack(m_evmVersion, yul::AssemblyStack::Language::EWasm, m_optimiserSettings);
-	// TODO this is a hack for now - provide as structured AST!
-	ewasmStack.parseAndAnalyze("", "{}");
-	*ewasmStack.parserResult() = move(ewasmObject);
+	// Inject into an assembly stack for the eWasm dialect, the translator already analyzed it.
+	yul::AssemblyStack ewasmStack(m_evmVersion, yul::AssemblyStack::Language::EWasm, contractOptimiserSettings(compiledContract));
+	bool analysisSuccessful = ewasmStack.analyze(move(ewasmObject));
+	solAssert(analysisSuccessful, "");
 	ewasmStack.optimize();
 
 	//cout << yul::AsmPrinter{}(*ewasmStack.parserResult()->code) << endl;
@@ -1261,9 +1525,6 @@ bytes CompilerStack::createCBORMetadata(string const& _metadata, bool _experimen
 
 string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) const
 {
-	if (m_stackState != CompilationSuccessful)
-		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
-
 	string ret;
 	map<string, unsigned> sourceIndicesMap = sourceIndices();
 	int prevStart = -1;
@@ -1378,44 +1639,64 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 	{
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
+		vector<pair<string, string>> externalNamesAndSignatures;
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			externalNamesAndSignatures.emplace_back(sig, sig);
 		}
 
 		if (contract.fallbackFunction())
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
-
-		if (!externalFunctions.empty())
-			output["external"] = externalFunctions;
+			externalNamesAndSignatures.emplace_back("", "INVALID");
 
 		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
+		vector<pair<FunctionDefinition const*, size_t>> internalFunctionsAndEntries;
 		for (auto const& it: contract.definedFunctions())
-		{
 			/// Exclude externally visible functions, constructor and the fallback function
-			if (it->isPartOfExternalInterface() || it->isConstructor() || it->isFallback())
-				continue;
+			if (!it->isPartOfExternalInterface() && !it->isConstructor() && !it->isFallback())
+				internalFunctionsAndEntries.emplace_back(it, functionEntryPoint(_contractName, *it));
+
+		// The estimates do not depend on each other, so they are computed concurrently.
+		vector<Gas> externalGas(externalNamesAndSignatures.size());
+		vector<Gas> internalGas(internalFunctionsAndEntries.size(), Gas::infinite());
+		TypeProvider& typeProvider = TypeProvider::instance();
+		parallelFor(externalGas.size() + internalGas.size(), m_workerThreads, [&](size_t _index)
+		{
+			TypeProvider::Scope typeProviderScope(typeProvider);
+			if (_index < externalGas.size())
+				externalGas[_index] = gasEstimator.functionalEstimation(*items, externalNamesAndSignatures[_index].second);
+			else
+			{
+				size_t i = _index - externalGas.size();
+				size_t entry = internalFunctionsAndEntries[i].second;
+				if (entry > 0)
+					internalGas[i] = gasEstimator.functionalEstimation(*items, entry, *internalFunctionsAndEntries[i].first);
+			}
+		});
 
-			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
-			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+		Json::Value externalFunctions(Json::objectValue);
+		for (size_t i = 0; i < externalGas.size(); ++i)
+			externalFunctions[externalNamesAndSignatures[i].first] = gasToJson(externalGas[i]);
+
+		if (!externalFunctions.empty())
+			output["external"] = externalFunctions;
 
+		Json::Value internalFunctions(Json::objectValue);
+		for (size_t i = 0; i < internalGas.size(); ++i)
+		{
+			FunctionDefinition const& function = *internalFunctionsAndEntries[i].first;
 			/// TODO: This could move into a method shared with externalSignature()
-			FunctionType type(*it);
-			string sig = it->name() + "(";
+			FunctionType type(function);
+			string sig = function.name() + "(";
 			auto paramTypes = type.parameterTypes();
 			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
 				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
 			sig += ")";
 
-			internalFunctions[sig] = gasToJson(gas);
+			internalFunctions[sig] = gasToJson(internalGas[i]);
 		}
 
 		if (!internalFunctions.empty())
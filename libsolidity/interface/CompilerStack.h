@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/SMTPortfolio.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
@@ -41,6 +42,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -51,6 +53,11 @@ namespace langutil
 class Scanner;
 }
 
+namespace yul
+{
+struct Object;
+}
+
 namespace dev
 {
 
@@ -70,6 +77,8 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class CompilationCache;
+class YulFunctionCache;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
@@ -155,12 +164,41 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Sets the number of threads used to parse sources and to compile contracts that do not
+	/// depend on each other.
+	/// Contracts that share a (transitive) contract dependency are always compiled on the same
+	/// thread, in the same order as with a single thread, so the output does not depend on this setting.
+	/// The Yul optimiser also uses this many threads to optimise functions.
+	/// All levels take their threads from dev::ThreadPool::shared(), so the total number of
+	/// threads is bounded by the size of that pool.
+	/// When called without an argument it will revert to the default (serial compilation).
+	/// Must be set before compiling.
+	void setWorkerThreads(unsigned _threads = 1);
+
+	/// Enables the on-disk compilation cache in @a _directory, which can be shared between
+	/// compiler runs. Requested contracts whose settings and sources (including all imported
+	/// sources) did not change are restored from the cache instead of being compiled again.
+	/// Restored contracts have bytecode and source mappings, but no assembly items, so there is
+	/// no assembly output and there are no gas estimates for them.
+	/// When called without an argument it will disable the cache.
+	/// Must be set before parsing.
+	void setCacheDirectory(std::string const& _directory = "");
+
+	/// Uses @a _cache as compilation cache (see setCacheDirectory), which allows sharing
+	/// its in-memory entries between subsequent compilations. A null pointer disables the cache.
+	/// Must be set before parsing.
+	void setCompilationCache(std::shared_ptr<CompilationCache const> _cache);
+
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
 	/// Enable experimental generation of eWasm code. If enabled, IR is also generated.
 	void enableEWasmGeneration(bool _enable = true) { m_generateEWasm = _enable; }
 
+	/// Enable recording the time and effect of the steps of the Yul optimiser for every contract.
+	/// Contracts are not restored from the compilation cache while this is enabled.
+	void enableYulOptimiserProfiling(bool _enable = true) { m_yulOptimiserProfiling = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -172,6 +210,10 @@ public:
 	/// Must be set before parsing.
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response);
 
+	/// Sets how the SMT checker combines its solvers, see smt::PortfolioSettings.
+	/// Must be set before analysis.
+	void setSMTSolverSettings(smt::PortfolioSettings const& _settings);
+
 	/// Parses all source units that were added
 	/// @returns false on error.
 	bool parse();
@@ -280,6 +322,10 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns a JSON representing the time spent in the steps of the Yul optimiser for a contract,
+	/// see yul::OptimiserProfile. It is null if profiling was not enabled or the contract was not compiled.
+	Json::Value yulOptimiserProfile(std::string const& _contractName) const;
+
 	/// Overwrites the release/prerelease flag. Should only be used for testing.
 	void overwriteReleaseFlag(bool release) { m_release = release; }
 private:
@@ -306,7 +352,10 @@ private:
 		eth::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Analyzed optimized Yul IR, used for further processing without parsing the text again.
+		std::shared_ptr<yul::Object> yulIRObject;
 		std::string eWasm; ///< Experimental eWasm code (text representation).
+		std::shared_ptr<yul::OptimiserProfile> yulOptimiserProfile; ///< Only set if profiling is enabled.
 		mutable std::unique_ptr<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		mutable std::unique_ptr<Json::Value const> abi;
 		mutable std::unique_ptr<Json::Value const> userDocumentation;
@@ -328,7 +377,12 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
-	/// Compile a single contract.
+	/// @returns the optimiser settings used to compile @a _contract. If profiling is enabled,
+	/// they refer to the optimiser profile of the contract, which is created if necessary.
+	OptimiserSettings contractOptimiserSettings(Contract& _contract) const;
+
+	/// Compile a single contract and store it in the compilation cache, unless it was restored
+	/// from there before.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
 	void compileContract(
@@ -336,6 +390,21 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// @returns the key of the compilation cache entry of a single contract. It is derived from the
+	/// metadata, which covers the compiler version, the settings and the hashes of all referenced
+	/// sources, and from everything else the bytecode and the source mappings depend on.
+	/// This assumes that compiling the same sources with the same settings always results in the
+	/// same bytecode, which is also what the metadata promises for source verification.
+	/// Settings that change the bytecode have to be added to the metadata or to the key.
+	h256 cacheKey(Contract const& _contract) const;
+
+	/// Restores the compilation results of a single contract from the cache.
+	/// @returns false if the cache is disabled or does not contain the contract.
+	bool loadFromCache(ContractDefinition const& _contract);
+
+	/// Stores the compilation results of a single, previously compiled contract in the cache.
+	void storeInCache(ContractDefinition const& _contract);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -365,7 +434,8 @@ private:
 	/// @returns the metadata CBOR for the given serialised metadata JSON.
 	bytes createCBORMetadata(std::string const& _metadata, bool _experimentalMode);
 
-	/// @returns the computer source mapping string.
+	/// @returns the computer source mapping string. Also used while the contracts are still being
+	/// compiled, so it does not check the state of the stack.
 	std::string computeSourceMapping(eth::AssemblyItems const& _items) const;
 
 	/// @returns the contract ABI as a JSON object.
@@ -397,6 +467,15 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateIR;
 	bool m_generateEWasm;
+	bool m_yulOptimiserProfiling = false;
+	unsigned m_workerThreads = 1;
+	std::shared_ptr<CompilationCache const> m_cache;
+	smt::PortfolioSettings m_smtSolverSettings;
+	/// Yul helper functions shared between the contracts of the current compilation.
+	std::shared_ptr<YulFunctionCache> m_yulFunctionCache;
+	/// Serialises the parts of the compilation that access the AST, its annotations
+	/// and the type system, which are shared between all contracts.
+	std::mutex m_codeGenerationMutex;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
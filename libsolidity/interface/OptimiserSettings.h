@@ -23,6 +23,12 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+
+namespace yul
+{
+class OptimiserProfile;
+}
 
 namespace dev
 {
@@ -104,6 +110,12 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Number of threads the optimisers may use to optimise independent Yul functions and
+	/// sub-assemblies concurrently. Does not influence the generated code and is thus not compared.
+	unsigned workerThreads = 1;
+	/// If set, the Yul optimiser records the time spent in its steps there.
+	/// Does not influence the generated code and is thus not compared.
+	std::shared_ptr<yul::OptimiserProfile> yulOptimiserProfile;
 };
 
 }
@@ -23,7 +23,9 @@
 #include <libsolidity/interface/StandardCompiler.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
@@ -159,14 +161,14 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
-	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast", "yulOptimizerProfile"};
 	for (auto const& artifact: _outputSelection)
 		/// @TODO support sub-matching, e.g "evm" matches "evm.assembly"
 		if (artifact == _artifact)
 			return true;
 		else if (artifact == "*")
 		{
-			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
+			// "ir", "irOptimized", "wast", "ewasm.wast" and "yulOptimizerProfile" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
 				return true;
 		}
@@ -234,7 +236,8 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences",
 		"evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap",
 		"evm.bytecode.linkReferences",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly",
+		"yulOptimizerProfile"
 	};
 
 	for (auto const& fileRequests: _outputSelection)
@@ -245,6 +248,26 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output was requested that needs the assembly of a contract, which is not
+/// available for contracts restored from the compilation cache.
+bool isAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	static vector<string> const outputsThatRequireAssembly{
+		"*",
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+	};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireAssembly)
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 /// @returns true if any eWasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEWasmRequested(Json::Value const& _outputSelection)
@@ -280,6 +303,22 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the profile of the Yul optimiser was requested. As profiling slows down
+/// the optimiser, it has to be requested explicitly and '*' does not match it.
+bool isYulOptimizerProfileRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "yulOptimizerProfile")
+					return true;
+
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -741,6 +780,11 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	compilerStack.enableEWasmGeneration(isEWasmRequested(_inputsAndSettings.outputSelection));
 
+	compilerStack.enableYulOptimiserProfiling(isYulOptimizerProfileRequested(_inputsAndSettings.outputSelection));
+
+	if (!isAssemblyRequested(_inputsAndSettings.outputSelection))
+		compilerStack.setCompilationCache(m_cache);
+
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
@@ -900,6 +944,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
 			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
 
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "yulOptimizerProfile", wildcardMatchesExperimental))
+			contractData["yulOptimizerProfile"] = compilerStack.yulOptimiserProfile(contractName);
+
 		// eWasm
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
 			contractData["ewasm"]["wast"] = compilerStack.eWasm(contractName);
@@ -969,6 +1016,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 	Json::Value output = Json::objectValue;
 
+	shared_ptr<yul::OptimiserProfile> profile;
+	if (isYulOptimizerProfileRequested(_inputsAndSettings.outputSelection))
+		_inputsAndSettings.optimiserSettings.yulOptimiserProfile = profile = make_shared<yul::OptimiserProfile>();
+
 	AssemblyStack stack(
 		_inputsAndSettings.evmVersion,
 		AssemblyStack::Language::StrictAssembly,
@@ -1027,6 +1078,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.assembly", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["evm"]["assembly"] = object.assembly;
+	if (profile)
+		output["contracts"][sourceName][contractName]["yulOptimizerProfile"] = profile->toJson();
 
 	return output;
 }
@@ -1034,7 +1087,13 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Other compilations might run concurrently in this process. They keep the Yul strings
+	// alive and each of them uses its own types and AST IDs.
+	YulStringRepository::resetIfUnused();
+	YulStringRepository::ScopedUse yulStringUse;
+	TypeProvider typeProvider;
+	TypeProvider::Scope typeProviderScope(typeProvider);
+	ASTNode::LocalIDScope idScope;
 
 	try
 	{
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <boost/optional.hpp>
@@ -48,8 +49,14 @@ public:
 	{
 	}
 
+	/// Enables the compilation cache for Solidity inputs that do not request assembly output
+	/// or gas estimates. The cache is shared by all subsequent calls to compile.
+	/// A null pointer disables the cache.
+	void setCompilationCache(std::shared_ptr<CompilationCache const> _cache) { m_cache = std::move(_cache); }
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
+	/// Can be called from several threads concurrently, on different instances.
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
@@ -79,6 +86,7 @@ private:
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<CompilationCache const> m_cache;
 };
 
 }
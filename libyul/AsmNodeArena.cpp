@@ -0,0 +1,135 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Chunked allocation of the Yul AST nodes that are owned through pointers.
+ */
+
+#include <libyul/AsmNodeArena.h>
+
+#include <atomic>
+
+using namespace std;
+using namespace yul;
+
+namespace
+{
+
+struct Chunk
+{
+	explicit Chunk(size_t _size): size(_size) {}
+	/// Number of live nodes in this chunk plus one while it is the current chunk of a thread.
+	atomic<size_t> references{1};
+	size_t size;
+};
+
+atomic<size_t> g_allocatedBytes{0};
+
+/// Precedes every node and points back to its chunk.
+struct alignas(alignof(max_align_t)) NodeHeader
+{
+	Chunk* chunk;
+};
+
+size_t const alignment = alignof(max_align_t);
+size_t const chunkSize = 16 * 1024;
+
+size_t aligned(size_t _size)
+{
+	return (_size + alignment - 1) / alignment * alignment;
+}
+
+size_t const chunkHeaderSize = aligned(sizeof(Chunk));
+
+Chunk* newChunk(size_t _size)
+{
+	Chunk* chunk = new (::operator new(_size)) Chunk(_size);
+	g_allocatedBytes.fetch_add(_size, memory_order_relaxed);
+	return chunk;
+}
+
+void release(Chunk* _chunk) noexcept
+{
+	if (_chunk && _chunk->references.fetch_sub(1, memory_order_acq_rel) == 1)
+	{
+		g_allocatedBytes.fetch_sub(_chunk->size, memory_order_relaxed);
+		_chunk->~Chunk();
+		::operator delete(_chunk);
+	}
+}
+
+/// The chunk a thread currently allocates from.
+struct Cursor
+{
+	~Cursor() { release(chunk); }
+
+	Chunk* chunk = nullptr;
+	char* next = nullptr;
+	char* end = nullptr;
+};
+
+thread_local Cursor t_cursor;
+
+void* placeNode(char* _position, Chunk* _chunk)
+{
+	NodeHeader* header = new (_position) NodeHeader{_chunk};
+	return header + 1;
+}
+
+}
+
+void* AsmNodeArena::allocate(size_t _size)
+{
+	size_t needed = sizeof(NodeHeader) + aligned(_size);
+	if (chunkHeaderSize + needed > chunkSize)
+	{
+		// Oversized nodes get a chunk of their own, which is only referenced by the node.
+		Chunk* chunk = newChunk(chunkHeaderSize + needed);
+		return placeNode(reinterpret_cast<char*>(chunk) + chunkHeaderSize, chunk);
+	}
+
+	Cursor& cursor = t_cursor;
+	if (size_t(cursor.end - cursor.next) < needed)
+	{
+		Chunk* chunk = newChunk(chunkSize);
+		release(cursor.chunk);
+		cursor.chunk = chunk;
+		cursor.next = reinterpret_cast<char*>(chunk) + chunkHeaderSize;
+		cursor.end = reinterpret_cast<char*>(chunk) + chunkSize;
+	}
+	cursor.chunk->references.fetch_add(1, memory_order_relaxed);
+	void* node = placeNode(cursor.next, cursor.chunk);
+	cursor.next += needed;
+	return node;
+}
+
+void AsmNodeArena::deallocate(void* _node) noexcept
+{
+	release((static_cast<NodeHeader*>(_node) - 1)->chunk);
+}
+
+void AsmNodeArena::startNewChunk()
+{
+	Cursor& cursor = t_cursor;
+	release(cursor.chunk);
+	cursor.chunk = nullptr;
+	cursor.next = cursor.end = nullptr;
+}
+
+size_t AsmNodeArena::allocatedBytes()
+{
+	return g_allocatedBytes.load(memory_order_relaxed);
+}
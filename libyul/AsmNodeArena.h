@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Chunked allocation of the Yul AST nodes that are owned through pointers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace yul
+{
+
+/**
+ * Bump allocator for AST nodes.
+ *
+ * Every thread allocates its nodes consecutively from its current chunk. A chunk counts the
+ * nodes that still live in it and is freed in one step as soon as the last of them is destroyed
+ * and the thread has moved on to another chunk. Nodes can be destroyed on any thread, so
+ * ASTs can be moved freely between threads and objects.
+ *
+ * A single surviving node keeps its whole chunk alive. ASTs that are kept after many
+ * temporary nodes were created, like the result of the optimiser, should therefore be copied
+ * into new chunks, see startNewChunk.
+ */
+class AsmNodeArena
+{
+public:
+	/// @returns uninitialised memory for a node of @a _size bytes.
+	static void* allocate(size_t _size);
+	/// Releases memory returned by allocate. The node must already be destroyed.
+	static void deallocate(void* _node) noexcept;
+	/// Makes the calling thread allocate the following nodes from a new chunk, so that they
+	/// do not keep the nodes of its current chunk alive.
+	static void startNewChunk();
+	/// @returns the number of bytes of all chunks that are currently allocated, by all threads.
+	static size_t allocatedBytes();
+};
+
+template <class T>
+struct AsmNodeDeleter
+{
+	void operator()(T* _node) const noexcept
+	{
+		_node->~T();
+		AsmNodeArena::deallocate(_node);
+	}
+};
+
+/// Owning pointer to an AST node, created by makeNode.
+template <class T>
+using NodePtr = std::unique_ptr<T, AsmNodeDeleter<T>>;
+
+/// Creates a new AST node in the arena, the replacement for std::make_unique.
+template <class T, class... Args>
+NodePtr<T> makeNode(Args&&... _args)
+{
+	void* memory = AsmNodeArena::allocate(sizeof(T));
+	try
+	{
+		return NodePtr<T>(new (memory) T(std::forward<Args>(_args)...));
+	}
+	catch (...)
+	{
+		AsmNodeArena::deallocate(memory);
+		throw;
+	}
+}
+
+}
@@ -61,9 +61,10 @@ shared_ptr<Block> Parser::parse(std::shared_ptr<Scanner> const& _scanner, bool _
 std::map<string, dev::eth::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, dev::eth::Instruction> s_instructions;
-	if (s_instructions.empty())
+	// Initialised by the initialiser of the static variable, because the parser is used by several threads.
+	static map<string, dev::eth::Instruction> const s_instructions = []()
 	{
+		map<string, dev::eth::Instruction> instructions;
 		for (auto const& instruction: dev::eth::c_instructions)
 		{
 			if (
@@ -73,9 +74,10 @@ std::map<string, dev::eth::Instruction> const& Parser::instructions()
 				continue;
 			string name = instruction.first;
 			transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
-			s_instructions[name] = instruction.second;
+			instructions[name] = instruction.second;
 		}
-	}
+		return instructions;
+	}();
 	return s_instructions;
 }
 
@@ -106,7 +108,7 @@ Statement Parser::parseStatement()
 	{
 		If _if = createWithLocation<If>();
 		advance();
-		_if.condition = make_unique<Expression>(parseExpression());
+		_if.condition = makeNode<Expression>(parseExpression());
 		_if.body = parseBlock();
 		return Statement{move(_if)};
 	}
@@ -114,7 +116,7 @@ Statement Parser::parseStatement()
 	{
 		Switch _switch = createWithLocation<Switch>();
 		advance();
-		_switch.expression = make_unique<Expression>(parseExpression());
+		_switch.expression = makeNode<Expression>(parseExpression());
 		while (currentToken() == Token::Case)
 			_switch.cases.emplace_back(parseCase());
 		if (currentToken() == Token::Default)
@@ -217,7 +219,7 @@ Statement Parser::parseStatement()
 
 		expectToken(Token::AssemblyAssign);
 
-		assignment.value.reset(new Expression(parseExpression()));
+		assignment.value = makeNode<Expression>(parseExpression());
 		assignment.location.end = locationOf(*assignment.value).end;
 
 		return Statement{std::move(assignment)};
@@ -274,7 +276,7 @@ Case Parser::parseCase()
 		ElementaryOperation literal = parseElementaryOperation();
 		if (literal.type() != typeid(Literal))
 			fatalParserError("Literal expected.");
-		_case.value = make_unique<Literal>(boost::get<Literal>(std::move(literal)));
+		_case.value = makeNode<Literal>(boost::get<Literal>(std::move(literal)));
 	}
 	else
 		solAssert(false, "Case or default case expected.");
@@ -294,7 +296,7 @@ ForLoop Parser::parseForLoop()
 	m_currentForLoopComponent = ForLoopComponent::ForLoopPre;
 	forLoop.pre = parseBlock();
 	m_currentForLoopComponent = ForLoopComponent::None;
-	forLoop.condition = make_unique<Expression>(parseExpression());
+	forLoop.condition = makeNode<Expression>(parseExpression());
 	m_currentForLoopComponent = ForLoopComponent::ForLoopPost;
 	forLoop.post = parseBlock();
 	m_currentForLoopComponent = ForLoopComponent::ForLoopBody;
@@ -363,15 +365,16 @@ Expression Parser::parseExpression()
 
 std::map<dev::eth::Instruction, string> const& Parser::instructionNames()
 {
-	static map<dev::eth::Instruction, string> s_instructionNames;
-	if (s_instructionNames.empty())
+	static map<dev::eth::Instruction, string> const s_instructionNames = []()
 	{
+		map<dev::eth::Instruction, string> instructionNames;
 		for (auto const& instr: instructions())
-			s_instructionNames[instr.second] = instr.first;
+			instructionNames[instr.second] = instr.first;
 		// set the ambiguous instructions to a clear default
-		s_instructionNames[dev::eth::Instruction::SELFDESTRUCT] = "selfdestruct";
-		s_instructionNames[dev::eth::Instruction::KECCAK256] = "keccak256";
-	}
+		instructionNames[dev::eth::Instruction::SELFDESTRUCT] = "selfdestruct";
+		instructionNames[dev::eth::Instruction::KECCAK256] = "keccak256";
+		return instructionNames;
+	}();
 	return s_instructionNames;
 }
 
@@ -482,7 +485,7 @@ VariableDeclaration Parser::parseVariableDeclaration()
 	if (currentToken() == Token::AssemblyAssign)
 	{
 		expectToken(Token::AssemblyAssign);
-		varDecl.value = make_unique<Expression>(parseExpression());
+		varDecl.value = makeNode<Expression>(parseExpression());
 		varDecl.location.end = locationOf(*varDecl.value).end;
 	}
 	else
@@ -43,6 +43,8 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 
+#include <functional>
+
 using namespace std;
 using namespace langutil;
 using namespace yul;
@@ -89,6 +91,29 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+bool AssemblyStack::analyze(shared_ptr<Object> _object)
+{
+	solAssert(_object && _object->code, "");
+	m_errors.clear();
+	m_analysisSuccessful = false;
+	m_scanner.reset();
+	m_parserResult = move(_object);
+
+	function<bool(Object&)> analyzeIfNeeded = [&](Object& _object) -> bool
+	{
+		if (!_object.analysisInfo)
+			return analyzeParsed(_object);
+		bool success = true;
+		for (auto& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				if (!analyzeIfNeeded(*subObject))
+					success = false;
+		return success;
+	};
+	m_analysisSuccessful = analyzeIfNeeded(*m_parserResult);
+	return m_analysisSuccessful;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -162,7 +187,10 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		dialect,
 		meter.get(),
 		_object,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		{},
+		m_optimiserSettings.workerThreads,
+		m_optimiserSettings.yulOptimiserProfile.get()
 	);
 }
 
@@ -77,6 +77,11 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Uses @a _object, which was constructed directly instead of being parsed, as input.
+	/// Only the objects that do not carry analysis information yet are analyzed.
+	/// Returns false if input cannot be assembled. Multiple calls overwrite the previous state.
+	bool analyze(std::shared_ptr<Object> _object);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -0,0 +1,235 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace yul;
+
+namespace
+{
+
+uint64_t const prime1 = 11400714785074694791u;
+uint64_t const prime2 = 14029467366897019727u;
+uint64_t const prime4 = 9650029242287828579u;
+uint64_t const prime5 = 2870177450012600261u;
+
+inline uint64_t rotateLeft(uint64_t _value, unsigned _bits)
+{
+	return (_value << _bits) | (_value >> (64 - _bits));
+}
+
+/// Reads little endian values independently of the platform.
+/// Compilers turn this into a single load on little endian machines.
+inline uint64_t read64(unsigned char const* _data)
+{
+	return
+		uint64_t(_data[0]) | (uint64_t(_data[1]) << 8) | (uint64_t(_data[2]) << 16) | (uint64_t(_data[3]) << 24) |
+		(uint64_t(_data[4]) << 32) | (uint64_t(_data[5]) << 40) | (uint64_t(_data[6]) << 48) | (uint64_t(_data[7]) << 56);
+}
+
+inline uint64_t read32(unsigned char const* _data)
+{
+	return uint64_t(_data[0]) | (uint64_t(_data[1]) << 8) | (uint64_t(_data[2]) << 16) | (uint64_t(_data[3]) << 24);
+}
+
+inline uint64_t accumulate(uint64_t _accumulator, uint64_t _input)
+{
+	return rotateLeft(_accumulator + _input * prime2, 31) * prime1;
+}
+
+inline uint64_t mergeRound(uint64_t _accumulator, uint64_t _value)
+{
+	return (_accumulator ^ accumulate(0, _value)) * prime1 + prime4;
+}
+
+}
+
+uint64_t YulStringRepository::hash(string const& _string)
+{
+	unsigned char const* data = reinterpret_cast<unsigned char const*>(_string.data());
+	unsigned char const* end = data + _string.size();
+	uint64_t h;
+
+	if (_string.size() >= 32)
+	{
+		// Four independent lanes, so that the processor can work on them in parallel.
+		uint64_t v1 = prime1 + prime2;
+		uint64_t v2 = prime2;
+		uint64_t v3 = 0;
+		uint64_t v4 = 0 - prime1;
+		for (; data + 32 <= end; data += 32)
+		{
+			v1 = accumulate(v1, read64(data));
+			v2 = accumulate(v2, read64(data + 8));
+			v3 = accumulate(v3, read64(data + 16));
+			v4 = accumulate(v4, read64(data + 24));
+		}
+		h = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+		h = mergeRound(h, v1);
+		h = mergeRound(h, v2);
+		h = mergeRound(h, v3);
+		h = mergeRound(h, v4);
+	}
+	else
+		h = prime5;
+
+	// Most identifiers are short, so the remaining bytes are processed with only one
+	// multiplication per word of eight bytes.
+	h += _string.size();
+	for (; data + 8 <= end; data += 8)
+		h = rotateLeft((h ^ read64(data)) * prime1, 31);
+	if (data < end)
+	{
+		// Combine the last up to seven bytes into a single word using (possibly overlapping) loads.
+		size_t remaining = size_t(end - data);
+		uint64_t tail;
+		if (_string.size() >= 8)
+			tail = read64(end - 8) >> (8 * (8 - remaining));
+		else if (remaining >= 4)
+			tail = read32(data) | (read32(end - 4) << 32);
+		else
+			tail = uint64_t(data[0]) | (uint64_t(data[remaining / 2]) << 8) | (uint64_t(end[-1]) << 16);
+		h = rotateLeft((h ^ tail) * prime1, 31);
+	}
+
+	h ^= h >> 32;
+	h *= prime2;
+	h ^= h >> 29;
+	return h;
+}
+
+YulStringRepository::YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		chunk.store(nullptr, memory_order_relaxed);
+	// Allocates the chunk of the empty string.
+	chunkForID(0);
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load(memory_order_relaxed);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	Shard& shard = m_shards[h % shardCount];
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.hashToID.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return Handle{it->second, h};
+
+	size_t id = m_nextID++;
+	chunkForID(id)[id % chunkSize] = _string;
+	shard.hashToID.emplace_hint(range.second, make_pair(h, id));
+
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	unique_lock<mutex> lock(usage().mutex);
+	resetWhenUnused(lock);
+}
+
+bool YulStringRepository::resetIfUnused()
+{
+	lock_guard<mutex> lock(usage().mutex);
+	if (usage().users > 0 || usage().resetPending)
+		return false;
+	resetUnlocked();
+	return true;
+}
+
+YulStringRepository::ScopedUse::ScopedUse()
+{
+	Usage& state = usage();
+	unique_lock<mutex> lock(state.mutex);
+	state.changed.wait(lock, [&]() { return !state.resetPending; });
+	if (instance().m_nextID > maxChunks * chunkSize / 2)
+		resetWhenUnused(lock);
+	++state.users;
+}
+
+YulStringRepository::ScopedUse::~ScopedUse()
+{
+	{
+		lock_guard<mutex> lock(usage().mutex);
+		--usage().users;
+	}
+	usage().changed.notify_all();
+}
+
+void YulStringRepository::resetWhenUnused(unique_lock<mutex>& _lock)
+{
+	Usage& state = usage();
+	state.changed.wait(_lock, [&]() { return !state.resetPending; });
+	state.resetPending = true;
+	state.changed.wait(_lock, [&]() { return state.users == 0; });
+	resetUnlocked();
+	state.resetPending = false;
+	state.changed.notify_all();
+}
+
+void YulStringRepository::resetUnlocked()
+{
+	{
+		lock_guard<mutex> lock(resetCallbacksMutex());
+		for (auto const& cb: resetCallbacks())
+			cb();
+	}
+	instance().clear();
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		shard.hashToID.clear();
+	}
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr);
+	m_nextID = 1;
+	chunkForID(0);
+}
+
+string* YulStringRepository::chunkForID(size_t _id)
+{
+	size_t index = _id / chunkSize;
+	yulAssert(index < maxChunks, "Too many distinct Yul strings.");
+	string* chunk = m_chunks[index].load(memory_order_acquire);
+	if (!chunk)
+	{
+		// Several threads might need the same new chunk, only one of them installs it.
+		unique_ptr<string[]> newChunk(new string[chunkSize]);
+		if (m_chunks[index].compare_exchange_strong(chunk, newChunk.get(), memory_order_acq_rel))
+			chunk = newChunk.release();
+	}
+	return chunk;
+}
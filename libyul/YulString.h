@@ -22,8 +22,12 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,6 +39,10 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository can be used from several threads concurrently. Looking up a string only locks
+/// one of several shards selected by the hash, retrieving the string for an ID does not lock at all.
+/// The strings are stored in chunks that are never moved or freed (apart from reset()),
+/// so IDs and references to the strings stay valid.
 class YulStringRepository
 {
 public:
@@ -50,71 +58,115 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		return m_chunks[_id / chunkSize].load(std::memory_order_acquire)[_id % chunkSize];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
-	static std::uint64_t hash(std::string const& v)
-	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
-		std::uint64_t hash = emptyHash();
-		for (auto c: v)
-		{
-			hash *= 1099511628211u;
-			hash ^= c;
-		}
-
-		return hash;
-	}
-	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// @returns a 64 bit hash of @a _string. It uses the primes and the round function of XXH64,
+	/// but is not compatible with it: Strings of 32 bytes or more are first processed in four
+	/// lanes of 32 byte blocks, then each remaining word of eight bytes and a last word of up to
+	/// seven bytes is mixed in with one multiplication and rotation, followed by a shorter
+	/// final mix.
+	/// The result does not depend on the platform, because YulString's <-operator is based on it.
+	static std::uint64_t hash(std::string const& _string);
+	/// @returns the hash of the empty string.
+	static constexpr std::uint64_t emptyHash() { return 0x88cf695d301700fdu; }
+	/// Clear the repository. Waits until no ScopedUse exists.
+	/// Use with care - there cannot be any dangling YulString references and
+	/// the repository must not be used concurrently.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
+	static void reset();
+	/// Clears the repository like reset(), but only if no ScopedUse exists.
+	/// @returns true if the repository was cleared.
+	static bool resetIfUnused();
+	/// Prevents the repository from being cleared while an instance exists, so that several
+	/// compilations can run concurrently in one process, each of which resets the repository
+	/// at its start using resetIfUnused.
+	/// Under constant load, there might never be a moment without a ScopedUse. Therefore, if the
+	/// repository is more than half full, the constructor waits until the existing instances are
+	/// gone and resets the repository. Instances created in the meantime wait for the reset.
+	/// Therefore, a thread must not create an instance while it already has one.
+	class ScopedUse
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	public:
+		ScopedUse();
+		~ScopedUse();
+		ScopedUse(ScopedUse const&) = delete;
+		ScopedUse& operator=(ScopedUse const&) = delete;
+	};
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	YulStringRepository();
+	~YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+	/// Number of ScopedUse instances and whether a reset waits for them to be gone.
+	struct Usage
+	{
+		std::mutex mutex;
+		std::condition_variable changed;
+		size_t users = 0;
+		bool resetPending = false;
+	};
+	static Usage& usage()
+	{
+		static Usage usage;
+		return usage;
+	}
+	/// Waits until there is no ScopedUse and no other pending reset and resets the repository.
+	/// @a _lock has to hold the usage mutex.
+	static void resetWhenUnused(std::unique_lock<std::mutex>& _lock);
+	/// Runs the reset callbacks and clears the repository. The caller has to hold the usage
+	/// mutex and there must not be any ScopedUse.
+	static void resetUnlocked();
+
+	/// Frees all chunks and starts over with only the empty string.
+	void clear();
+	/// @returns the chunk that stores the string with ID @a _id, allocating it if needed.
+	std::string* chunkForID(size_t _id);
+
+	/// Number of strings per chunk.
+	static constexpr size_t chunkSize = 4096;
+	/// Maximum number of chunks, limits the number of strings to about 67 million.
+	static constexpr size_t maxChunks = 16384;
+	/// Number of shards of the lookup table.
+	static constexpr size_t shardCount = 64;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, shardCount> m_shards;
+	/// ID of the next string to be stored, the empty string has ID zero.
+	std::atomic<size_t> m_nextID{1};
+	/// Pointers to the chunks of strings, allocated on demand.
+	std::array<std::atomic<std::string*>, maxChunks> m_chunks;
 };
 
 /// Wrapper around handles into the YulString repository.
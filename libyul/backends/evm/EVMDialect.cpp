@@ -34,12 +34,21 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
 
 namespace
 {
+/// Protects the dialect instances, which are created on first use, also from parallel compilation.
+mutex& dialectsMutex()
+{
+	static mutex dialectsMutex;
+	return dialectsMutex;
+}
+
 pair<YulString, BuiltinFunctionForEVM> createEVMFunction(
 	string const& _name,
 	dev::eth::Instruction _instruction
@@ -194,6 +203,7 @@ EVMDialect const& EVMDialect::looseAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Loose, false, _version);
 	return *dialects[_version];
@@ -203,6 +213,7 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, false, _version);
 	return *dialects[_version];
@@ -212,6 +223,7 @@ EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, true, _version);
 	return *dialects[_version];
@@ -221,6 +233,7 @@ EVMDialect const& EVMDialect::yulForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Yul, false, _version);
 	return *dialects[_version];
@@ -20,6 +20,8 @@
 
 #include <libyul/backends/wasm/WasmDialect.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace yul;
 
@@ -82,6 +84,8 @@ WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
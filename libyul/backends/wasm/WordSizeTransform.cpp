@@ -53,7 +53,7 @@ void WordSizeTransform::operator()(FunctionCall& _fc)
 
 void WordSizeTransform::operator()(If& _if)
 {
-	_if.condition = make_unique<Expression>(FunctionCall{
+	_if.condition = makeNode<Expression>(FunctionCall{
 		locationOf(*_if.condition),
 		Identifier{locationOf(*_if.condition), "or_bool"_yulstring},
 		expandValueToVector(*_if.condition)
@@ -69,7 +69,7 @@ void WordSizeTransform::operator()(Switch&)
 void WordSizeTransform::operator()(ForLoop& _for)
 {
 	(*this)(_for.pre);
-	_for.condition = make_unique<Expression>(FunctionCall{
+	_for.condition = makeNode<Expression>(FunctionCall{
 		locationOf(*_for.condition),
 		Identifier{locationOf(*_for.condition), "or_bool"_yulstring},
 		expandValueToVector(*_for.condition)
@@ -236,7 +236,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 
 	Switch ret{
 		_location,
-		make_unique<Expression>(Identifier{_location, _splitExpressions.at(_depth)}),
+		makeNode<Expression>(Identifier{_location, _splitExpressions.at(_depth)}),
 		{}
 	};
 
@@ -245,7 +245,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 		Literal label{_location, LiteralKind::Number, YulString(c.first.str()), "u64"_yulstring};
 		ret.cases.emplace_back(Case{
 			c.second.front().location,
-			make_unique<Literal>(std::move(label)),
+			makeNode<Literal>(std::move(label)),
 			Block{_location, handleSwitchInternal(
 				_location,
 				_splitExpressions,
@@ -263,7 +263,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 				Assignment{
 					_location,
 					{{_location, _runDefaultFlag}},
-					make_unique<Expression>(Literal{_location, LiteralKind::Number, "1"_yulstring, "u64"_yulstring})
+					makeNode<Expression>(Literal{_location, LiteralKind::Number, "1"_yulstring, "u64"_yulstring})
 				}
 			)}
 		});
@@ -306,7 +306,7 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 	if (!runDefaultFlag.empty())
 		ret.emplace_back(If{
 			_switch.location,
-			make_unique<Expression>(Identifier{_switch.location, runDefaultFlag}),
+			makeNode<Expression>(Identifier{_switch.location, runDefaultFlag}),
 			std::move(defaultCase.body)
 		});
 	return ret;
@@ -321,14 +321,14 @@ array<YulString, 4> WordSizeTransform::generateU64IdentifierNames(YulString cons
 	return m_variableMapping[_s];
 }
 
-array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e)
+array<NodePtr<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e)
 {
-	array<unique_ptr<Expression>, 4> ret;
+	array<NodePtr<Expression>, 4> ret;
 	if (_e.type() == typeid(Identifier))
 	{
 		Identifier const& id = boost::get<Identifier>(_e);
 		for (int i = 0; i < 4; i++)
-			ret[i] = make_unique<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
+			ret[i] = makeNode<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
 	}
 	else if (_e.type() == typeid(Literal))
 	{
@@ -338,7 +338,7 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 		{
 			u256 currentVal = val & std::numeric_limits<uint64_t>::max();
 			val >>= 64;
-			ret[i] = make_unique<Expression>(
+			ret[i] = makeNode<Expression>(
 				Literal{
 					lit.location,
 					LiteralKind::Number,
@@ -356,7 +356,7 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 vector<Expression> WordSizeTransform::expandValueToVector(Expression const& _e)
 {
 	vector<Expression> ret;
-	for (unique_ptr<Expression>& val: expandValue(_e))
+	for (NodePtr<Expression>& val: expandValue(_e))
 		ret.emplace_back(std::move(*val));
 	return ret;
 }
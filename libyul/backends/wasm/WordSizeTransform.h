@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/AsmNodeArena.h>
 
 #include <liblangutil/SourceLocation.h>
 
@@ -90,7 +91,7 @@ private:
 	);
 
 	std::array<YulString, 4> generateU64IdentifierNames(YulString const& _s);
-	std::array<std::unique_ptr<Expression>, 4> expandValue(Expression const& _e);
+	std::array<NodePtr<Expression>, 4> expandValue(Expression const& _e);
 	std::vector<Expression> expandValueToVector(Expression const& _e);
 
 	Dialect const& m_inputDialect;
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
+#include <libyul/AsmNodeArena.h>
 
 #include <libyul/YulString.h>
 
@@ -97,9 +98,9 @@ protected:
 	std::vector<T> translateVector(std::vector<T> const& _values);
 
 	template <typename T>
-	std::unique_ptr<T> translate(std::unique_ptr<T> const& _v)
+	NodePtr<T> translate(NodePtr<T> const& _v)
 	{
-		return _v ? std::make_unique<T>(translate(*_v)) : nullptr;
+		return _v ? makeNode<T>(translate(*_v)) : nullptr;
 	}
 
 	Block translate(Block const& _block);
@@ -119,6 +120,7 @@ template <typename T>
 std::vector<T> ASTCopier::translateVector(std::vector<T> const& _values)
 {
 	std::vector<T> translated;
+	translated.reserve(_values.size());
 	for (auto const& v: _values)
 		translated.emplace_back(translate(v));
 	return translated;
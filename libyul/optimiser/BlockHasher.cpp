@@ -20,6 +20,7 @@
 
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/Exceptions.h>
 #include <libyul/Utilities.h>
 #include <libdevcore/CommonData.h>
 
@@ -31,7 +32,7 @@ namespace
 {
 static constexpr uint64_t compileTimeLiteralHash(char const* _literal, size_t _N)
 {
-	return (_N == 0) ? BlockHasher::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * BlockHasher::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _N - 1);
+	return (_N == 0) ? ASTHasherBase::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * ASTHasherBase::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _N - 1);
 }
 
 template<size_t N>
@@ -49,6 +50,32 @@ std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 	return result;
 }
 
+uint64_t BlockHasher::hash(Block const& _block)
+{
+	std::map<Block const*, uint64_t> blockHashes;
+	BlockHasher blockHasher(blockHashes);
+	blockHasher(_block);
+	return blockHasher.m_hash;
+}
+
+uint64_t BlockHasher::hash(FunctionDefinition const& _function)
+{
+	std::map<Block const*, uint64_t> blockHashes;
+	BlockHasher blockHasher(blockHashes);
+	blockHasher.hash64(compileTimeLiteralHash("FunctionDefinition"));
+	blockHasher.hash64(_function.parameters.size());
+	blockHasher.hash64(_function.returnVariables.size());
+	// Declare the parameters and return variables in order, otherwise they would be numbered
+	// in the order of their first use in the body.
+	for (auto const& var: _function.parameters + _function.returnVariables)
+		blockHasher.m_variableReferences[var.name] = VariableReference{
+			blockHasher.m_internalIdentifierCount++,
+			false
+		};
+	blockHasher(_function.body);
+	return blockHasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -155,8 +182,6 @@ void BlockHasher::operator()(FunctionDefinition const& _funDef)
 
 void BlockHasher::operator()(ForLoop const& _loop)
 {
-	yulAssert(_loop.pre.statements.empty(), "");
-
 	hash64(compileTimeLiteralHash("ForLoop"));
 	ASTWalker::operator()(_loop);
 }
@@ -193,3 +218,67 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ExpressionHasher::run(Expression const& _expression)
+{
+	ExpressionHasher hasher;
+	hasher.visit(_expression);
+	return hasher.m_hash;
+}
+
+uint64_t ExpressionHasher::run(Expression const& _expression, vector<uint64_t> const& _argumentHashes)
+{
+	ExpressionHasher hasher{&_argumentHashes};
+	hasher.visit(_expression);
+	return hasher.m_hash;
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	if (_literal.kind == LiteralKind::Number)
+	{
+		// SyntacticallyEqual compares number literals by value, e.g. 0x10 equals 16.
+		u256 value = valueOfNumberLiteral(_literal);
+		for (unsigned i = 0; i < 4; ++i)
+			hash64(static_cast<uint64_t>((value >> (64 * i)) & u256(0xFFFFFFFFFFFFFFFF)));
+	}
+	else
+		hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionalInstruction const& _instr)
+{
+	hash64(compileTimeLiteralHash("FunctionalInstruction"));
+	hash8(static_cast<std::underlying_type_t<eth::Instruction>>(_instr.instruction));
+	hashArguments(_instr.arguments);
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hashArguments(_funCall.arguments);
+}
+
+void ExpressionHasher::hashArguments(vector<Expression> const& _arguments)
+{
+	hash64(_arguments.size());
+	if (m_argumentHashes)
+	{
+		assertThrow(m_argumentHashes->size() == _arguments.size(), OptimizerException, "");
+		for (uint64_t argumentHash: *m_argumentHashes)
+			hash64(argumentHash);
+	}
+	else
+		for (Expression const& argument: _arguments)
+			hash64(run(argument));
+}
@@ -27,6 +27,40 @@
 namespace yul
 {
 
+/**
+ * Common functionality of the hashers of Yul AST nodes below.
+ */
+class ASTHasherBase: public ASTWalker
+{
+public:
+	static constexpr uint64_t fnvPrime = 1099511628211u;
+	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+
+protected:
+	void hash8(uint8_t _value)
+	{
+		m_hash *= fnvPrime;
+		m_hash ^= _value;
+	}
+	void hash16(uint16_t _value)
+	{
+		hash8(static_cast<uint8_t>(_value & 0xFF));
+		hash8(static_cast<uint8_t>(_value >> 8));
+	}
+	void hash32(uint32_t _value)
+	{
+		hash16(static_cast<uint16_t>(_value & 0xFFFF));
+		hash16(static_cast<uint16_t>(_value >> 16));
+	}
+	void hash64(uint64_t _value)
+	{
+		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
+		hash32(static_cast<uint32_t>(_value >> 32));
+	}
+
+	uint64_t m_hash = fnvEmptyHash;
+};
+
 /**
  * Optimiser component that calculates hash values for blocks.
  * Syntactically equal blocks will have identical hashes and
@@ -41,7 +75,7 @@ namespace yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
-class BlockHasher: public ASTWalker
+class BlockHasher: public ASTHasherBase
 {
 public:
 
@@ -63,37 +97,19 @@ public:
 	void operator()(Block const& _block) override;
 
 	static std::map<Block const*, uint64_t> run(Block const& _block);
-
-	static constexpr uint64_t fnvPrime = 1099511628211u;
-	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+	/// @returns the hash of @a _block, without the hashes of the blocks inside.
+	/// Does not require the ForLoopInitRewriter, the initialisation parts of for loops are
+	/// hashed like any other block.
+	static uint64_t hash(Block const& _block);
+	/// @returns the hash of the body of @a _function together with its signature, i.e. the
+	/// number and the order of its parameters and return variables.
+	static uint64_t hash(FunctionDefinition const& _function);
 
 private:
 	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
 
-	void hash8(uint8_t _value)
-	{
-		m_hash *= fnvPrime;
-		m_hash ^= _value;
-	}
-	void hash16(uint16_t _value)
-	{
-		hash8(static_cast<uint8_t>(_value & 0xFF));
-		hash8(static_cast<uint8_t>(_value >> 8));
-	}
-	void hash32(uint32_t _value)
-	{
-		hash16(static_cast<uint16_t>(_value & 0xFFFF));
-		hash16(static_cast<uint16_t>(_value >> 16));
-	}
-	void hash64(uint64_t _value)
-	{
-		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
-		hash32(static_cast<uint32_t>(_value >> 32));
-	}
-
 	std::map<Block const*, uint64_t>& m_blockHashes;
 
-	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
 	{
 		size_t id = 0;
@@ -105,5 +121,39 @@ private:
 	size_t m_internalIdentifierCount = 0;
 };
 
+/**
+ * Optimiser component that calculates hash values for expressions.
+ * Expressions that are equal according to SyntacticallyEqual (without
+ * any declared variables) have identical hashes. In contrast to BlockHasher,
+ * the names of referenced variables are taken into account.
+ *
+ * The hash of a function call only depends on the hashes of its arguments,
+ * so the hashes of nested expressions can be calculated bottom-up.
+ */
+class ExpressionHasher: public ASTHasherBase
+{
+public:
+	/// @returns the hash of @a _expression.
+	static uint64_t run(Expression const& _expression);
+	/// @returns the hash of @a _expression, where @a _argumentHashes are the hashes
+	/// of its arguments if it is a function call or an instruction. The arguments
+	/// themselves are not visited.
+	static uint64_t run(Expression const& _expression, std::vector<uint64_t> const& _argumentHashes);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionalInstruction const& _instr) override;
+	void operator()(FunctionCall const& _funCall) override;
+
+private:
+	explicit ExpressionHasher(std::vector<uint64_t> const* _argumentHashes = nullptr): m_argumentHashes(_argumentHashes) {}
+
+	void hashArguments(std::vector<Expression> const& _arguments);
+
+	std::vector<uint64_t> const* m_argumentHashes = nullptr;
+};
+
 
 }
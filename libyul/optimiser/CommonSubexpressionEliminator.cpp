@@ -21,12 +21,15 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
 #include <libyul/Dialect.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -49,8 +52,23 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	// Note that the DataFlowAnalyzer itself only has code for visiting Statements,
 	// so this basically invokes the AST walker directly and thus post-visiting
 	// is also fine with regards to data flow analysis.
+	// The visits of the arguments add their hashes to argumentHashes, in reverse order.
+	vector<uint64_t> argumentHashes;
+	vector<uint64_t>* outerArgumentHashes = m_argumentHashes;
+	m_argumentHashes = &argumentHashes;
 	if (descend)
 		DataFlowAnalyzer::visit(_e);
+	m_argumentHashes = outerArgumentHashes;
+
+	// Hashing the expression bottom-up avoids visiting the arguments again.
+	uint64_t hash = 0;
+	if (descend)
+	{
+		reverse(argumentHashes.begin(), argumentHashes.end());
+		hash = ExpressionHasher::run(_e, argumentHashes);
+	}
+	else
+		hash = ExpressionHasher::run(_e);
 
 	if (_e.type() == typeid(Identifier))
 	{
@@ -64,21 +82,45 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 				YulString value = boost::get<Identifier>(*m_value.at(name)).name;
 				assertThrow(inScope(value), OptimizerException, "");
 				_e = Identifier{locationOf(_e), value};
+				hash = ExpressionHasher::run(_e);
 			}
 		}
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& var: m_value)
-		{
-			assertThrow(var.second, OptimizerException, "");
-			assertThrow(inScope(var.first), OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *var.second))
+		auto candidates = m_replacementCandidates.find(hash);
+		if (candidates != m_replacementCandidates.end())
+			// The candidates are ordered by name like m_value, so the choice among several
+			// variables with the same value does not change.
+			for (YulString variable: candidates->second)
 			{
-				_e = Identifier{locationOf(_e), var.first};
-				break;
+				auto value = m_value.find(variable);
+				if (value == m_value.end())
+					continue;
+				assertThrow(value->second, OptimizerException, "");
+				if (SyntacticallyEqual{}(_e, *value->second))
+				{
+					assertThrow(inScope(variable), OptimizerException, "");
+					_e = Identifier{locationOf(_e), variable};
+					hash = ExpressionHasher::run(_e);
+					break;
+				}
 			}
-		}
 	}
+
+	if (m_argumentHashes)
+		m_argumentHashes->push_back(hash);
+	m_lastExpression = &_e;
+	m_lastExpressionHash = hash;
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	if (_value && _value->type() != typeid(Identifier))
+	{
+		// The value was usually just visited, so its hash is known.
+		uint64_t hash = _value == m_lastExpression ? m_lastExpressionHash : ExpressionHasher::run(*_value);
+		m_replacementCandidates[hash].insert(_variable);
+	}
+	DataFlowAnalyzer::assignValue(_variable, _value);
 }
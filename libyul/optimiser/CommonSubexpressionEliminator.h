@@ -23,6 +23,10 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <set>
+#include <unordered_map>
+#include <vector>
+
 namespace yul
 {
 
@@ -32,6 +36,9 @@ struct Dialect;
  * Optimisation stage that replaces expressions known to be the current value of a variable
  * in scope by a reference to that variable.
  *
+ * Candidate variables are looked up by the hash of the expression, so the step does
+ * not have to compare every expression with the values of all variables.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class CommonSubexpressionEliminator: public DataFlowAnalyzer
@@ -42,6 +49,19 @@ public:
 protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
+
+	void assignValue(YulString _variable, Expression const* _value) override;
+
+private:
+	/// Variables that were assigned an expression with the given hash at some point.
+	/// Entries are never removed, so the current value of a candidate has to be checked
+	/// against m_value before it is used.
+	std::unordered_map<uint64_t, std::set<YulString>> m_replacementCandidates;
+	/// Collects the hashes of the arguments of the expression that is being visited.
+	std::vector<uint64_t>* m_argumentHashes = nullptr;
+	/// The expression that was visited last and its hash.
+	Expression const* m_lastExpression = nullptr;
+	uint64_t m_lastExpressionHash = 0;
 };
 
 }
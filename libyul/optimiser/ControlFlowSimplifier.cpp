@@ -99,7 +99,7 @@ OptionalStatements reduceSingleCaseSwitch(Dialect const& _dialect, Switch& _swit
 			return {};
 		return make_vector<Statement>(If{
 			std::move(_switchStmt.location),
-			make_unique<Expression>(FunctionCall{
+			makeNode<Expression>(FunctionCall{
 				loc,
 				Identifier{loc, _dialect.equalityFunction()->name},
 				{std::move(*switchCase.value), std::move(*_switchStmt.expression)}
@@ -86,6 +86,10 @@ protected:
 	/// Registers the assignment.
 	void handleAssignment(std::set<YulString> const& _names, Expression* _value);
 
+	/// Records @a _value as the current value of @a _variable. Derived classes can override
+	/// this to keep additional indices of the values in sync with m_value.
+	virtual void assignValue(YulString _variable, Expression const* _value);
+
 	/// Creates a new inner scope.
 	void pushScope(bool _functionScope);
 
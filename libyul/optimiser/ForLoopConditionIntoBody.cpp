@@ -32,7 +32,7 @@ void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 			_forLoop.body.statements.begin(),
 			If {
 				loc,
-				make_unique<Expression>(
+				makeNode<Expression>(
 					FunctionalInstruction {
 						loc,
 						eth::Instruction::ISZERO,
@@ -42,7 +42,7 @@ void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 				Block {loc, make_vector<Statement>(Break{{}})}
 			}
 		);
-		_forLoop.condition = make_unique<Expression>(
+		_forLoop.condition = makeNode<Expression>(
 			Literal {
 				loc,
 				LiteralKind::Number,
@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Time and effect of the steps of the optimiser suite.
+ */
+
+#include <libyul/optimiser/OptimiserProfile.h>
+
+using namespace std;
+using namespace yul;
+
+void OptimiserProfile::record(
+	Stage _stage,
+	size_t _round,
+	size_t _index,
+	string const& _name,
+	chrono::nanoseconds _time,
+	size_t _sizeBefore,
+	size_t _sizeAfter,
+	bool _changed
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto inserted = m_steps.insert({make_tuple(_stage, _round, _index, _name), Step{_stage, _round, _index, _name}});
+	Step& step = inserted.first->second;
+	step.runs++;
+	if (_changed)
+		step.changedRuns++;
+	step.time += _time;
+	step.sizeDelta += int64_t(_sizeAfter) - int64_t(_sizeBefore);
+}
+
+void OptimiserProfile::recordSuiteRun(size_t _rounds)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_suiteRuns++;
+	m_rounds += _rounds;
+}
+
+vector<OptimiserProfile::Step> OptimiserProfile::steps() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	vector<Step> steps;
+	for (auto const& step: m_steps)
+		steps.push_back(step.second);
+	return steps;
+}
+
+size_t OptimiserProfile::suiteRuns() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_suiteRuns;
+}
+
+size_t OptimiserProfile::rounds() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_rounds;
+}
+
+Json::Value OptimiserProfile::toJson() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	Json::Value output{Json::objectValue};
+	output["suiteRuns"] = Json::UInt64(m_suiteRuns);
+	output["rounds"] = Json::UInt64(m_rounds);
+	output["steps"] = Json::arrayValue;
+	for (auto const& keyAndStep: m_steps)
+	{
+		Step const& step = keyAndStep.second;
+		Json::Value entry{Json::objectValue};
+		switch (step.stage)
+		{
+		case Stage::Preparation:
+			entry["stage"] = "preparation";
+			break;
+		case Stage::Round:
+			entry["stage"] = "round";
+			entry["round"] = Json::UInt64(step.round);
+			break;
+		case Stage::Finalisation:
+			entry["stage"] = "finalisation";
+			break;
+		}
+		entry["index"] = Json::UInt64(step.index);
+		entry["name"] = step.name;
+		entry["runs"] = Json::UInt64(step.runs);
+		entry["changedRuns"] = Json::UInt64(step.changedRuns);
+		entry["timeNanoseconds"] = Json::UInt64(step.time.count());
+		entry["sizeDelta"] = Json::Int64(step.sizeDelta);
+		output["steps"].append(entry);
+	}
+	return output;
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Time and effect of the steps of the optimiser suite.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace yul
+{
+
+/**
+ * Collects, for every step of the optimiser suite, how long the step took and how it changed
+ * the code. A step is identified by its stage, its round, its index in the sequence of steps
+ * of the stage and its name, so steps that occur several times in the sequence are recorded
+ * separately. The name distinguishes the steps that depend on the dialect. All runs of the
+ * same step are added up: the runs on the individual functions and the runs in other
+ * invocations of the suite (e.g. for several objects).
+ * Can be used from several threads.
+ */
+class OptimiserProfile
+{
+public:
+	enum class Stage { Preparation, Round, Finalisation };
+
+	struct Step
+	{
+		Stage stage;
+		/// The round of the main loop, starting at one. Zero outside of Stage::Round.
+		size_t round;
+		/// The position of the step in the sequence of the stage (of every round), starting at zero.
+		size_t index;
+		std::string name;
+		/// How often the step was applied, to a single function or to the whole code.
+		size_t runs = 0;
+		/// How many of the runs changed the code, apart from renaming variables.
+		size_t changedRuns = 0;
+		std::chrono::nanoseconds time{0};
+		/// Sum of the changes of the code size (see CodeSize::codeSizeIncludingFunctions)
+		/// over all runs, negative if the step made the code smaller.
+		std::int64_t sizeDelta = 0;
+	};
+
+	void record(
+		Stage _stage,
+		size_t _round,
+		size_t _index,
+		std::string const& _name,
+		std::chrono::nanoseconds _time,
+		size_t _sizeBefore,
+		size_t _sizeAfter,
+		bool _changed
+	);
+	/// Records that the suite finished after @a _rounds rounds of the main loop.
+	void recordSuiteRun(size_t _rounds);
+
+	/// @returns the steps sorted by stage, round, index and name, i.e. independently of the order
+	/// in which they were run.
+	std::vector<Step> steps() const;
+	/// @returns the number of times the suite was run.
+	size_t suiteRuns() const;
+	/// @returns the total number of rounds over all runs of the suite.
+	size_t rounds() const;
+
+	Json::Value toJson() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::tuple<Stage, size_t, size_t, std::string>, Step> m_steps;
+	size_t m_suiteRuns = 0;
+	size_t m_rounds = 0;
+};
+
+}
@@ -65,7 +65,7 @@ void SSAReverser::operator()(Block& _block)
 						VariableDeclaration{
 							std::move(varDecl->location),
 							std::move(varDecl->variables),
-							std::make_unique<Expression>(std::move(assignment->variableNames.front()))
+							makeNode<Expression>(std::move(assignment->variableNames.front()))
 						}
 					);
 			}
@@ -87,7 +87,7 @@ void SSAReverser::operator()(Block& _block)
 					)
 				)
 				{
-					auto varIdentifier2 = std::make_unique<Expression>(Identifier{
+					auto varIdentifier2 = makeNode<Expression>(Identifier{
 						varDecl2->variables.front().location,
 						varDecl2->variables.front().name
 					});
@@ -102,7 +102,7 @@ void SSATransform::operator()(Block& _block)
 					statements.emplace_back(VariableDeclaration{
 						loc,
 						{TypedName{loc, oldName, {}}},
-						make_unique<Expression>(Identifier{loc, newName})
+						makeNode<Expression>(Identifier{loc, newName})
 					});
 				}
 				boost::get<VariableDeclaration>(statements.front()).variables = std::move(newVariables);
@@ -129,7 +129,7 @@ void SSATransform::operator()(Block& _block)
 					statements.emplace_back(Assignment{
 						loc,
 						{Identifier{loc, oldName}},
-						make_unique<Expression>(Identifier{loc, newName})
+						makeNode<Expression>(Identifier{loc, newName})
 					});
 				}
 				boost::get<VariableDeclaration>(statements.front()).variables = std::move(newVariables);
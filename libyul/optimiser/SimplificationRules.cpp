@@ -46,11 +46,49 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static SimplificationRules rules;
+	// The rules store the expressions of the last match, so every thread needs its own copy.
+	static thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
+	// The index only refers to the rules by position, so it can be shared by all threads.
+	static SimplificationRuleIndex<Pattern> const index(rules.m_rules);
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	// This has to agree with Pattern::matches, which resolves variables for
+	// all patterns except "Any".
+	auto shapeOf = [&](Expression const& _expression, vector<Expression const*>& o_arguments)
 	{
+		Expression const* expression = &_expression;
+		if (_expression.type() == typeid(Identifier))
+		{
+			YulString varName = boost::get<Identifier>(_expression).name;
+			if (_ssaValues.count(varName))
+				if (Expression const* value = _ssaValues.at(varName))
+					expression = value;
+		}
+
+		PatternShape shape;
+		if (expression->type() == typeid(Literal))
+		{
+			Literal const& literal = boost::get<Literal>(*expression);
+			if (literal.kind == LiteralKind::Number)
+			{
+				shape.kind = PatternShape::Kind::Constant;
+				shape.value = u256(literal.value.str());
+			}
+		}
+		else if (auto instructionAndArgs = instructionAndArguments(_dialect, *expression))
+		{
+			shape.kind = PatternShape::Kind::Operation;
+			shape.instruction = instructionAndArgs->first;
+			for (Expression const& argument: *instructionAndArgs->second)
+				o_arguments.push_back(&argument);
+		}
+		return shape;
+	};
+
+	index.candidates(_expr, shapeOf, rules.m_candidates, rules.m_pendingExpressions);
+	for (size_t ruleIndex: rules.m_candidates)
+	{
+		auto const& rule = rules.m_rules[ruleIndex];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -61,7 +99,7 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(dev::eth::Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 boost::optional<std::pair<dev::eth::Instruction, vector<Expression> const*>>
@@ -86,7 +124,8 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	assertThrow(_rule.pattern.shape().kind == PatternShape::Kind::Operation, OptimizerException, "Rules have to start with an operation.");
+	m_rules.push_back(_rule);
 }
 
 SimplificationRules::SimplificationRules()
@@ -201,6 +240,23 @@ bool Pattern::matches(
 	return true;
 }
 
+PatternShape Pattern::shape() const
+{
+	PatternShape shape;
+	if (m_kind == PatternKind::Operation)
+	{
+		shape.kind = PatternShape::Kind::Operation;
+		shape.instruction = m_instruction;
+	}
+	else if (m_kind == PatternKind::Constant)
+	{
+		shape.kind = PatternShape::Kind::Constant;
+		if (m_data)
+			shape.value = *m_data;
+	}
+	return shape;
+}
+
 dev::eth::Instruction Pattern::instruction() const
 {
 	assertThrow(m_kind == PatternKind::Operation, OptimizerException, "");
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/AsmData.h>
@@ -45,7 +46,7 @@ public:
 	SimplificationRules();
 
 	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// groups accordingly. Only the rules selected by the rule index are tried.
 	/// @param _ssaValues values of variables that are assigned exactly once.
 	static dev::eth::SimplificationRule<Pattern> const* findFirstMatch(
 		Expression const& _expr,
@@ -67,7 +68,10 @@ private:
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules[256];
+	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules;
+	/// Buffers for the rule index that are reused by all lookups.
+	std::vector<size_t> m_candidates;
+	std::vector<Expression const*> m_pendingExpressions;
 };
 
 enum class PatternKind
@@ -103,6 +107,8 @@ public:
 		Dialect const& _dialect,
 		std::map<YulString, Expression const*> const& _ssaValues
 	) const;
+	/// @returns the shape of this pattern for dev::eth::SimplificationRuleIndex.
+	dev::eth::PatternShape shape() const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
@@ -20,9 +20,11 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -44,6 +46,9 @@
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDisplacer.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -54,50 +59,353 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libdevcore/Common.h>
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Parallel.h>
+
+#include <chrono>
 
 using namespace std;
 using namespace dev;
 using namespace yul;
 
+namespace
+{
+
+/// @returns the hashes of the parts of the grouped AST @a _ast: the main block, which uses the
+/// empty name, and the functions, including their signatures.
+map<YulString, uint64_t> hashParts(Block const& _ast)
+{
+	map<YulString, uint64_t> hashes;
+	for (Statement const& statement: _ast.statements)
+		if (FunctionDefinition const* function = boost::get<FunctionDefinition>(&statement))
+			hashes[function->name] = BlockHasher::hash(*function);
+		else
+			hashes[YulString{}] = BlockHasher::hash(boost::get<Block>(statement));
+	return hashes;
+}
+
+/// Determines the parts of the grouped AST @a _ast (see hashParts) that the previous round of
+/// the suite did not change at any point, see @a _changedParts, and that only call functions
+/// that were not changed either. Another round would not change them.
+/// @a _hashes has to contain the hashes of the parts at the start of the previous round
+/// and is updated to the current ones.
+set<YulString> unchangedParts(
+	Block const& _ast,
+	map<YulString, uint64_t>& _hashes,
+	set<YulString> const& _changedParts
+)
+{
+	auto combine = [](uint64_t _hash, uint64_t _value) {
+		return (_hash * BlockHasher::fnvPrime) ^ _value;
+	};
+
+	set<YulString> functionNames;
+	for (size_t i = 1; i < _ast.statements.size(); ++i)
+		functionNames.insert(boost::get<FunctionDefinition>(_ast.statements[i]).name);
+	// Inlining a function depends on whether it is only called once, so this is part of the
+	// hashes of its callers.
+	map<YulString, size_t> references = ReferencesCounter::countReferences(_ast);
+
+	map<YulString, uint64_t> hashes = hashParts(_ast);
+	map<YulString, set<YulString>> callees;
+	for (Statement const& statement: _ast.statements)
+	{
+		YulString name;
+		map<YulString, size_t> calls;
+		if (FunctionDefinition const* function = boost::get<FunctionDefinition>(&statement))
+		{
+			name = function->name;
+			calls = ReferencesCounter::countReferences(*function);
+		}
+		else
+			calls = ReferencesCounter::countReferences(boost::get<Block>(statement));
+		for (auto const& call: calls)
+			if (functionNames.count(call.first))
+			{
+				callees[name].insert(call.first);
+				hashes[name] = combine(hashes[name], references[call.first] == 1);
+			}
+	}
+
+	set<YulString> unchanged;
+	for (auto const& hash: hashes)
+		if (
+			!_changedParts.count(hash.first) &&
+			_hashes.count(hash.first) &&
+			_hashes.at(hash.first) == hash.second
+		)
+			unchanged.insert(hash.first);
+	for (bool removed = true; removed;)
+	{
+		removed = false;
+		for (auto it = unchanged.begin(); it != unchanged.end();)
+			if (any_of(callees[*it].begin(), callees[*it].end(), [&](YulString _callee) { return !unchanged.count(_callee); }))
+			{
+				it = unchanged.erase(it);
+				removed = true;
+			}
+			else
+				++it;
+	}
+
+	_hashes = std::move(hashes);
+	return unchanged;
+}
+
+/// Applies @a _steps to the main block and to every function of @a _ast separately,
+/// distributing them over up to @a _threads threads. The steps must only modify the block
+/// they are given and must not depend on the code of other functions. Parts whose names
+/// (the empty name for the main block) are in @a _skippedParts are left unchanged.
+/// Every part gets its own name dispenser, so the result does not depend on the order in which
+/// the parts are processed. Names that are declared in more than one part afterwards are
+/// replaced in all but the first part, so names stay unique across the whole AST.
+void runPerFunction(
+	Dialect const& _dialect,
+	Block& _ast,
+	set<YulString> const& _reservedIdentifiers,
+	unsigned _threads,
+	set<YulString> const& _skippedParts,
+	function<void(Block&, NameDispenser&)> const& _steps
+)
+{
+	FunctionGrouper{}(_ast);
+
+	// Move every function into a block of its own, so that the steps can be applied to it in
+	// isolation. The first part is the main block itself.
+	vector<Block> functions(_ast.statements.size() - 1);
+	set<YulString> functionNames;
+	for (size_t i = 0; i < functions.size(); ++i)
+	{
+		functionNames.insert(boost::get<FunctionDefinition>(_ast.statements[i + 1]).name);
+		functions[i].location = _ast.location;
+		functions[i].statements.emplace_back(std::move(_ast.statements[i + 1]));
+	}
+	auto part = [&](size_t _index) -> Block& {
+		return _index == 0 ? boost::get<Block>(_ast.statements.front()) : functions[_index - 1];
+	};
+	auto partName = [&](size_t _index) {
+		return _index == 0 ? YulString{} : boost::get<FunctionDefinition>(functions[_index - 1].statements.front()).name;
+	};
+	// @returns the names declared in a part, apart from the name of the function itself.
+	auto localNames = [&](size_t _index) {
+		set<YulString> names = NameCollector(part(_index)).names();
+		if (_index > 0)
+			names.erase(partName(_index));
+		return names;
+	};
+
+	vector<set<YulString>> declaredNames(functions.size() + 1);
+	parallelFor(declaredNames.size(), _threads, [&](size_t _index)
+	{
+		Block& block = part(_index);
+		if (!_skippedParts.count(partName(_index)))
+		{
+			set<YulString> usedNames = NameCollector(block).names() + _reservedIdentifiers;
+			for (auto const& reference: ReferencesCounter::countReferences(block))
+				usedNames.insert(reference.first);
+			NameDispenser dispenser{_dialect, std::move(usedNames)};
+			_steps(block, dispenser);
+		}
+		declaredNames[_index] = localNames(_index);
+	});
+
+	set<YulString> allNames = _reservedIdentifiers + functionNames;
+	for (auto const& names: declaredNames)
+		allNames += names;
+	NameDispenser dispenser{_dialect, std::move(allNames)};
+
+	set<YulString> seen = _reservedIdentifiers + functionNames;
+	for (size_t i = 0; i < declaredNames.size(); ++i)
+	{
+		set<YulString> clashes;
+		for (YulString name: declaredNames[i])
+			if (seen.count(name))
+				clashes.insert(name);
+		if (!clashes.empty())
+		{
+			NameDisplacer{dispenser, clashes}(part(i));
+			declaredNames[i] = localNames(i);
+		}
+		seen += declaredNames[i];
+	}
+
+	for (size_t i = 0; i < functions.size(); ++i)
+		_ast.statements[i + 1] = std::move(functions[i].statements.front());
+}
+
+/// Applies single optimiser steps and records them in the profile, if there is one.
+/// The steps are numbered by their position in the sequence of steps of the current stage.
+class StepRunner
+{
+public:
+	explicit StepRunner(OptimiserProfile* _profile): m_profile(_profile) {}
+
+	void setStage(OptimiserProfile::Stage _stage, size_t _round = 0)
+	{
+		m_stage = _stage;
+		m_round = _round;
+		m_index = 0;
+	}
+
+	/// Runs @a _step, which is called @a _name and modifies @a _block.
+	template <class F>
+	void operator()(char const* _name, Block const& _block, F const& _step)
+	{
+		if (!m_profile)
+		{
+			_step();
+			return;
+		}
+		size_t index = partIndex() ? (*partIndex())++ : m_index++;
+		if (m_countOnly)
+			return;
+		// Measuring the code is not part of the time of the step.
+		size_t sizeBefore = CodeSize::codeSizeIncludingFunctions(_block);
+		uint64_t hashBefore = BlockHasher::hash(_block);
+		auto start = chrono::steady_clock::now();
+		_step();
+		auto time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+		m_profile->record(
+			m_stage,
+			m_round,
+			index,
+			_name,
+			time,
+			sizeBefore,
+			CodeSize::codeSizeIncludingFunctions(_block),
+			BlockHasher::hash(_block) != hashBefore
+		);
+	}
+
+	/// Applies the sequence of steps @a _steps to the parts of the code using @a _apply,
+	/// which might process the parts concurrently. The steps get the same positions for
+	/// every part, as if the sequence was run once.
+	void perPart(
+		Dialect const& _dialect,
+		function<void(function<void(Block&, NameDispenser&)> const&)> const& _apply,
+		function<void(Block&, NameDispenser&)> const& _steps
+	)
+	{
+		if (!m_profile)
+		{
+			_apply(_steps);
+			return;
+		}
+		size_t const first = m_index;
+		_apply([&](Block& _block, NameDispenser& _dispenser)
+		{
+			size_t index = first;
+			partIndex() = &index;
+			ScopeGuard resetIndex([]() { partIndex() = nullptr; });
+			_steps(_block, _dispenser);
+		});
+		// Counts the steps without running them, since @a _apply might have skipped all parts.
+		m_countOnly = true;
+		ScopeGuard resetCountOnly([&]() { m_countOnly = false; });
+		Block block;
+		NameDispenser dispenser{_dialect, set<YulString>{}};
+		_steps(block, dispenser);
+	}
+
+private:
+	/// The position of the next step in the sequence that the current thread applies to a part.
+	static size_t*& partIndex()
+	{
+		thread_local size_t* index = nullptr;
+		return index;
+	}
+
+	OptimiserProfile* m_profile = nullptr;
+	OptimiserProfile::Stage m_stage = OptimiserProfile::Stage::Preparation;
+	size_t m_round = 0;
+	/// The position of the next step in the sequence of the stage.
+	size_t m_index = 0;
+	/// If set, steps are numbered but not run.
+	bool m_countOnly = false;
+};
+
+}
+
 void OptimiserSuite::run(
 	Dialect const& _dialect,
 	GasMeter const* _meter,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	unsigned _threads,
+	OptimiserProfile* _profile
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
-	*_object.code = boost::get<Block>(Disambiguator(
-		_dialect,
-		*_object.analysisInfo,
-		reservedIdentifiers
-	)(*_object.code));
+	StepRunner step{_profile};
+	step("Disambiguator", *_object.code, [&]() {
+		*_object.code = boost::get<Block>(Disambiguator(
+			_dialect,
+			*_object.analysisInfo,
+			reservedIdentifiers
+		)(*_object.code));
+	});
 	Block& ast = *_object.code;
 
-	VarDeclInitializer{}(ast);
-	FunctionHoister{}(ast);
-	BlockFlattener{}(ast);
-	ForLoopInitRewriter{}(ast);
-	DeadCodeEliminator{_dialect}(ast);
-	FunctionGrouper{}(ast);
-	EquivalentFunctionCombiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	BlockFlattener{}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
-	StructuralSimplifier{_dialect}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
-	BlockFlattener{}(ast);
+	step("VarDeclInitializer", ast, [&]() { VarDeclInitializer{}(ast); });
+	step("FunctionHoister", ast, [&]() { FunctionHoister{}(ast); });
+	step("BlockFlattener", ast, [&]() { BlockFlattener{}(ast); });
+	step("ForLoopInitRewriter", ast, [&]() { ForLoopInitRewriter{}(ast); });
+	step("DeadCodeEliminator", ast, [&]() { DeadCodeEliminator{_dialect}(ast); });
+	step("FunctionGrouper", ast, [&]() { FunctionGrouper{}(ast); });
+	step("EquivalentFunctionCombiner", ast, [&]() { EquivalentFunctionCombiner::run(ast); });
+	step("UnusedPruner", ast, [&]() { UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers); });
+	step("BlockFlattener", ast, [&]() { BlockFlattener{}(ast); });
+	step("ControlFlowSimplifier", ast, [&]() { ControlFlowSimplifier{_dialect}(ast); });
+	step("StructuralSimplifier", ast, [&]() { StructuralSimplifier{_dialect}(ast); });
+	step("ControlFlowSimplifier", ast, [&]() { ControlFlowSimplifier{_dialect}(ast); });
+	step("BlockFlattener", ast, [&]() { BlockFlattener{}(ast); });
 
 	// None of the above can make stack problems worse.
 
-	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
+	// Parts that were not changed by the previous round are skipped by the per-function steps.
+	// The global steps still see them. Skipped parts are in the same state as at every point of
+	// the previous round, so the global steps behave as before, unless they depend on parts
+	// that did change. Therefore, parts are compared to the start of the round before and after
+	// every group of per-function steps, and a skipped part that a global step changed is no
+	// longer skipped.
+	map<YulString, uint64_t> partHashes;
+	map<YulString, uint64_t> roundStartHashes;
+	set<YulString> changed;
+	set<YulString> unchanged;
+	auto checkpoint = [&]()
+	{
+		FunctionGrouper{}(ast);
+		for (auto const& hash: hashParts(ast))
+		{
+			auto it = roundStartHashes.find(hash.first);
+			if (it == roundStartHashes.end() || it->second != hash.second)
+			{
+				changed.insert(hash.first);
+				unchanged.erase(hash.first);
+			}
+		}
+	};
+	auto perFunction = [&](function<void(Block&, NameDispenser&)> const& _steps)
+	{
+		checkpoint();
+		step.perPart(_dialect, [&](function<void(Block&, NameDispenser&)> const& _indexedSteps)
+		{
+			runPerFunction(_dialect, ast, reservedIdentifiers, _threads, unchanged, _indexedSteps);
+		}, _steps);
+		checkpoint();
+	};
+	auto pruneUnused = [&]()
+	{
+		step("UnusedPruner", ast, [&]() { UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers); });
+	};
 
 	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < 12; ++rounds)
+	size_t rounds = 0;
+	for (; rounds < 12; ++rounds)
 	{
 		{
 			size_t newSize = CodeSize::codeSizeIncludingFunctions(ast);
@@ -105,126 +413,152 @@ void OptimiserSuite::run(
 				break;
 			codeSize = newSize;
 		}
+		step.setStage(OptimiserProfile::Stage::Round, rounds + 1);
 
+		FunctionGrouper{}(ast);
+		unchanged = unchangedParts(ast, partHashes, changed);
+		changed.clear();
+		roundStartHashes = hashParts(ast);
+
+		perFunction([&](Block& _block, NameDispenser& _dispenser)
 		{
 			// Turn into SSA and simplify
-			ExpressionSplitter{_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
+			step("ExpressionSplitter", _block, [&]() { ExpressionSplitter{_dialect, _dispenser}(_block); });
+			step("SSATransform", _block, [&]() { SSATransform::run(_block, _dispenser); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
 
-			ExpressionSimplifier::run(_dialect, ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-		}
+			step("ExpressionSimplifier", _block, [&]() { ExpressionSimplifier::run(_dialect, _block); });
+			step("CommonSubexpressionEliminator", _block, [&]() { CommonSubexpressionEliminator{_dialect}(_block); });
 
-		{
 			// still in SSA, perform structural simplification
-			ControlFlowSimplifier{_dialect}(ast);
-			StructuralSimplifier{_dialect}(ast);
-			ControlFlowSimplifier{_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		}
+			step("ControlFlowSimplifier", _block, [&]() { ControlFlowSimplifier{_dialect}(_block); });
+			step("StructuralSimplifier", _block, [&]() { StructuralSimplifier{_dialect}(_block); });
+			step("ControlFlowSimplifier", _block, [&]() { ControlFlowSimplifier{_dialect}(_block); });
+			step("BlockFlattener", _block, [&]() { BlockFlattener{}(_block); });
+			step("DeadCodeEliminator", _block, [&]() { DeadCodeEliminator{_dialect}(_block); });
+		});
+		pruneUnused();
+
 		{
 			// simplify again
-			CommonSubexpressionEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+			perFunction([&](Block& _block, NameDispenser&)
+			{
+				step("CommonSubexpressionEliminator", _block, [&]() { CommonSubexpressionEliminator{_dialect}(_block); });
+			});
+			pruneUnused();
 		}
 
 		{
 			// reverse SSA
-			SSAReverser::run(ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-
-			ExpressionJoiner::run(ast);
-			ExpressionJoiner::run(ast);
+			perFunction([&](Block& _block, NameDispenser&)
+			{
+				step("SSAReverser", _block, [&]() { SSAReverser::run(_block); });
+				step("CommonSubexpressionEliminator", _block, [&]() { CommonSubexpressionEliminator{_dialect}(_block); });
+			});
+			pruneUnused();
+
+			perFunction([&](Block& _block, NameDispenser&)
+			{
+				step("ExpressionJoiner", _block, [&]() { ExpressionJoiner::run(_block); });
+				step("ExpressionJoiner", _block, [&]() { ExpressionJoiner::run(_block); });
+			});
 		}
 
 		// should have good "compilability" property here.
 
 		{
 			// run functional expression inliner
-			ExpressionInliner(_dialect, ast).run();
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+			step("ExpressionInliner", ast, [&]() { ExpressionInliner(_dialect, ast).run(); });
+			pruneUnused();
 		}
 
+		perFunction([&](Block& _block, NameDispenser& _dispenser)
 		{
 			// Turn into SSA again and simplify
-			ExpressionSplitter{_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-		}
+			step("ExpressionSplitter", _block, [&]() { ExpressionSplitter{_dialect, _dispenser}(_block); });
+			step("SSATransform", _block, [&]() { SSATransform::run(_block, _dispenser); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+			step("CommonSubexpressionEliminator", _block, [&]() { CommonSubexpressionEliminator{_dialect}(_block); });
+		});
 
 		{
 			// run full inliner
 			FunctionGrouper{}(ast);
-			EquivalentFunctionCombiner::run(ast);
-			FullInliner{ast, dispenser}.run();
-			BlockFlattener{}(ast);
+			step("EquivalentFunctionCombiner", ast, [&]() { EquivalentFunctionCombiner::run(ast); });
+			step("FullInliner", ast, [&]() {
+				NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
+				FullInliner{ast, dispenser}.run();
+			});
+			step("BlockFlattener", ast, [&]() { BlockFlattener{}(ast); });
 		}
 
+		// SSA plus simplify
+		perFunction([&](Block& _block, NameDispenser& _dispenser)
 		{
-			// SSA plus simplify
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			ExpressionSimplifier::run(_dialect, ast);
-			StructuralSimplifier{_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{_dialect}(ast);
-			ControlFlowSimplifier{_dialect}(ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-			CommonSubexpressionEliminator{_dialect}(ast);
-		}
+			step("SSATransform", _block, [&]() { SSATransform::run(_block, _dispenser); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+			step("ExpressionSimplifier", _block, [&]() { ExpressionSimplifier::run(_dialect, _block); });
+			step("StructuralSimplifier", _block, [&]() { StructuralSimplifier{_dialect}(_block); });
+			step("BlockFlattener", _block, [&]() { BlockFlattener{}(_block); });
+			step("DeadCodeEliminator", _block, [&]() { DeadCodeEliminator{_dialect}(_block); });
+			step("ControlFlowSimplifier", _block, [&]() { ControlFlowSimplifier{_dialect}(_block); });
+			step("CommonSubexpressionEliminator", _block, [&]() { CommonSubexpressionEliminator{_dialect}(_block); });
+			step("SSATransform", _block, [&]() { SSATransform::run(_block, _dispenser); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+			step("RedundantAssignEliminator", _block, [&]() { RedundantAssignEliminator::run(_dialect, _block); });
+		});
+		pruneUnused();
+		perFunction([&](Block& _block, NameDispenser&)
+		{
+			step("CommonSubexpressionEliminator", _block, [&]() { CommonSubexpressionEliminator{_dialect}(_block); });
+		});
 	}
 
 	// Make source short and pretty.
+	step.setStage(OptimiserProfile::Stage::Finalisation);
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+	step("ExpressionJoiner", ast, [&]() { ExpressionJoiner::run(ast); });
+	step("Rematerialiser", ast, [&]() { Rematerialiser::run(_dialect, ast); });
+	pruneUnused();
+	step("ExpressionJoiner", ast, [&]() { ExpressionJoiner::run(ast); });
+	pruneUnused();
+	step("ExpressionJoiner", ast, [&]() { ExpressionJoiner::run(ast); });
+	pruneUnused();
 
-	SSAReverser::run(ast);
-	CommonSubexpressionEliminator{_dialect}(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+	step("SSAReverser", ast, [&]() { SSAReverser::run(ast); });
+	step("CommonSubexpressionEliminator", ast, [&]() { CommonSubexpressionEliminator{_dialect}(ast); });
+	pruneUnused();
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+	step("ExpressionJoiner", ast, [&]() { ExpressionJoiner::run(ast); });
+	step("Rematerialiser", ast, [&]() { Rematerialiser::run(_dialect, ast); });
+	pruneUnused();
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
 	FunctionGrouper{}(ast);
-	// We ignore the return value because we will get a much better error
-	// message once we perform code generation.
-	StackCompressor::run(
-		_dialect,
-		_object,
-		_optimizeStackAllocation,
-		stackCompressorMaxIterations
-	);
-	BlockFlattener{}(ast);
-	DeadCodeEliminator{_dialect}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
+	step("StackCompressor", ast, [&]() {
+		// We ignore the return value because we will get a much better error
+		// message once we perform code generation.
+		StackCompressor::run(
+			_dialect,
+			_object,
+			_optimizeStackAllocation,
+			stackCompressorMaxIterations
+		);
+	});
+	step("BlockFlattener", ast, [&]() { BlockFlattener{}(ast); });
+	step("DeadCodeEliminator", ast, [&]() { DeadCodeEliminator{_dialect}(ast); });
+	step("ControlFlowSimplifier", ast, [&]() { ControlFlowSimplifier{_dialect}(ast); });
 
 	FunctionGrouper{}(ast);
 
 	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
 		yulAssert(_meter, "");
-		ConstantOptimiser{*dialect, *_meter}(ast);
+		step("ConstantOptimiser", ast, [&]() { ConstantOptimiser{*dialect, *_meter}(ast); });
 	}
 	else if (dynamic_cast<WasmDialect const*>(&_dialect))
 	{
@@ -233,7 +567,15 @@ void OptimiserSuite::run(
 		if (ast.statements.size() > 1 && boost::get<Block>(ast.statements.front()).statements.empty())
 			ast.statements.erase(ast.statements.begin());
 	}
-	VarNameCleaner{ast, _dialect, reservedIdentifiers}(ast);
+	step("VarNameCleaner", ast, [&]() { VarNameCleaner{ast, _dialect, reservedIdentifiers}(ast); });
+
+	// The nodes of the result are spread over chunks that mostly contain the temporary nodes
+	// of the optimiser steps, so it is copied into new chunks.
+	AsmNodeArena::startNewChunk();
+	ast = boost::get<Block>(ASTCopier{}(ast));
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+
+	if (_profile)
+		_profile->recordSuiteRun(rounds);
 }
@@ -33,10 +33,15 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimiserProfile;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
+ *
+ * Steps that only look at a single function are applied to all functions independently,
+ * using up to @a _threads threads. The result does not depend on the number of threads.
+ * If @a _profile is given, the time and effect of every step is recorded there.
  */
 class OptimiserSuite
 {
@@ -46,7 +51,9 @@ public:
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		unsigned _threads = 1,
+		OptimiserProfile* _profile = nullptr
 	);
 };
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
+#include <libyul/AsmNodeArena.h>
 #include <libyul/YulString.h>
 
 #include <map>
@@ -78,7 +79,7 @@ private:
 	}
 
 	template<typename T, bool (SyntacticallyEqual::*CompareMember)(T const&, T const&)>
-	bool compareUniquePtr(std::unique_ptr<T> const& _lhs, std::unique_ptr<T> const& _rhs)
+	bool compareUniquePtr(NodePtr<T> const& _lhs, NodePtr<T> const& _rhs)
 	{
 		return (_lhs == _rhs) || (_lhs && _rhs && (this->*CompareMember)(*_lhs, *_rhs));
 	}
@@ -38,7 +38,7 @@ void VarDeclInitializer::operator()(Block& _block)
 			Literal zero{{}, LiteralKind::Number, YulString{"0"}, {}};
 			if (_varDecl.variables.size() == 1)
 			{
-				_varDecl.value = make_unique<Expression>(std::move(zero));
+				_varDecl.value = makeNode<Expression>(std::move(zero));
 				return {};
 			}
 			else
@@ -46,7 +46,7 @@ void VarDeclInitializer::operator()(Block& _block)
 				OptionalStatements ret{vector<Statement>{}};
 				langutil::SourceLocation loc{std::move(_varDecl.location)};
 				for (auto& var: _varDecl.variables)
-					ret->emplace_back(VariableDeclaration{loc, {std::move(var)}, make_unique<Expression>(zero)});
+					ret->emplace_back(VariableDeclaration{loc, {std::move(var)}, makeNode<Expression>(zero)});
 				return ret;
 			}
 		}
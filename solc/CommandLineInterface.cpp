@@ -30,11 +30,14 @@
 #include <libsolidity/ast/ASTPrinter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -64,6 +67,7 @@
 #endif
 
 #include <string>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 
@@ -109,6 +113,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -122,6 +127,7 @@ static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
 static string const g_strYul = "yul";
+static string const g_strYulOptimizerProfile = "yul-optimizer-profile";
 static string const g_strIR = "ir";
 static string const g_strEWasm = "ewasm";
 static string const g_strLicense = "license";
@@ -138,13 +144,18 @@ static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
+static string const g_strSMTCacheDir = "smt-cache-dir";
+static string const g_strSMTRace = "smt-race";
+static string const g_strSMTTimeout = "smt-timeout";
 static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
+static string const g_strThreads = "threads";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
@@ -170,6 +181,7 @@ static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
 static string const g_argYul = g_strYul;
+static string const g_argYulOptimizerProfile = g_strYulOptimizerProfile;
 static string const g_argIR = g_strIR;
 static string const g_argEWasm = g_strEWasm;
 static string const g_argLibraries = g_strLibraries;
@@ -241,7 +253,7 @@ static void license()
 
 static bool needsHumanTargetedStdout(po::variables_map const& _args)
 {
-	if (_args.count(g_argGas))
+	if (_args.count(g_argGas) || _args.count(g_argYulOptimizerProfile))
 		return true;
 	if (_args.count(g_argOutputDir))
 		return false;
@@ -453,6 +465,114 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 	}
 }
 
+void CommandLineInterface::handleYulOptimizerProfile(Json::Value const& _profile)
+{
+	sout() << "Yul optimizer profile:" << endl;
+	if (!_profile.isObject() || _profile["suiteRuns"].asUInt64() == 0)
+	{
+		sout() << "   The Yul optimizer did not run." << endl;
+		return;
+	}
+	sout() <<
+		"   " << _profile["suiteRuns"].asUInt64() << " optimizer runs, " <<
+		_profile["rounds"].asUInt64() << " rounds" << endl;
+
+	// Add up the rounds, the numbers of every round are only part of the JSON output.
+	struct Totals
+	{
+		uint64_t runs = 0;
+		uint64_t changes = 0;
+		uint64_t nanoseconds = 0;
+		int64_t sizeChange = 0;
+	};
+	map<string, Totals> totals;
+	for (auto const& step: _profile["steps"])
+	{
+		Totals& total = totals[step["name"].asString()];
+		total.runs += step["runs"].asUInt64();
+		total.changes += step["changes"].asUInt64();
+		total.nanoseconds += step["timeNanoseconds"].asUInt64();
+		total.sizeChange += step["sizeAfter"].asInt64() - step["sizeBefore"].asInt64();
+	}
+	vector<pair<string, Totals>> sorted(totals.begin(), totals.end());
+	stable_sort(sorted.begin(), sorted.end(), [](pair<string, Totals> const& _a, pair<string, Totals> const& _b) {
+		return _a.second.nanoseconds > _b.second.nanoseconds;
+	});
+
+	sout() << "   " << left << setw(32) << "step" << right << setw(12) << "time (ms)" << setw(8) << "runs";
+	sout() << setw(10) << "changes" << setw(14) << "size change" << endl;
+	for (auto const& step: sorted)
+	{
+		sout() << "   " << left << setw(32) << step.first << right << fixed << setprecision(3);
+		sout() << setw(12) << double(step.second.nanoseconds) / 1e6 << setw(8) << step.second.runs;
+		sout() << setw(10) << step.second.changes << setw(14) << step.second.sizeChange << endl;
+	}
+}
+
+bool CommandLineInterface::serve(ReadCallback::Callback const& _fileReader)
+{
+	// Files requested through the callback while compiling the current input.
+	map<string, ReadCallback::Result> filesRead;
+	StandardCompiler compiler([&](string const& _path)
+	{
+		ReadCallback::Result result = _fileReader(_path);
+		filesRead[_path] = result;
+		return result;
+	});
+	// The in-memory part of the cache is kept for the whole session.
+	compiler.setCompilationCache(make_shared<CompilationCache>(
+		m_args.count(g_strCacheDir) ? m_args[g_strCacheDir].as<string>() : ""
+	));
+
+	// The previous input and its output, which is reused if the input is repeated and none of
+	// the files read while compiling it changed in the meantime.
+	string lastInput;
+	string lastOutput;
+	map<string, ReadCallback::Result> lastFilesRead;
+	auto filesUnchanged = [&]()
+	{
+		for (auto const& file: lastFilesRead)
+		{
+			ReadCallback::Result result = _fileReader(file.first);
+			if (
+				result.success != file.second.success ||
+				result.responseOrErrorMessage != file.second.responseOrErrorMessage
+			)
+				return false;
+		}
+		return true;
+	};
+
+	string input;
+	while (getline(cin, input))
+	{
+		if (input.find_first_not_of(" \t\r") == string::npos)
+			continue;
+		if (lastOutput.empty() || input != lastInput || !filesUnchanged())
+		{
+			filesRead.clear();
+			lastOutput = compiler.compile(input);
+			lastInput = move(input);
+			lastFilesRead = move(filesRead);
+		}
+		sout() << lastOutput << endl;
+	}
+	return true;
+}
+
+bool CommandLineInterface::assemblyRequested() const
+{
+	if (m_args.count(g_argAsm) || m_args.count(g_argAsmJson) || m_args.count(g_argGas))
+		return true;
+	if (m_args.count(g_argCombinedJson))
+	{
+		set<string> requests;
+		boost::split(requests, m_args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
+		return requests.count(g_strAsm);
+	}
+	return false;
+}
+
 bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 {
 	bool ignoreMissing = m_args.count(g_argIgnoreMissingFiles);
@@ -651,6 +771,28 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to compile contracts that do not depend on each other "
+			"and to optimise Yul functions. The output does not depend on this setting."
+		)
+		(
+			g_strSMTRace.c_str(),
+			"Run the SMT solvers of the SMTChecker concurrently and use the first definite answer "
+			"instead of querying them one after the other."
+		)
+		(
+			g_strSMTTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Time in milliseconds a single query of the SMTChecker may take across all solvers."
+		)
+		(
+			g_strSMTCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the answers of the SMT solvers in the given directory and reuse them "
+			"when the SMTChecker runs the same query again."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -671,11 +813,23 @@ Allowed options)",
 			"Output a single json document containing the specified information."
 		)
 		(g_argGas.c_str(), "Print an estimate of the maximal gas usage for each function.")
+		(
+			g_argYulOptimizerProfile.c_str(),
+			"Print the time spent in each step of the Yul optimizer and how the steps changed the code. "
+			"The Standard JSON output \"yulOptimizerProfile\" also contains the numbers of every round."
+		)
 		(
 			g_argStandardJSON.c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_strServer.c_str(),
+			"Switch to server mode, ignoring all options except --allow-paths and --cache-dir. "
+			"It reads one Standard JSON input per line from standard input and writes the output "
+			"for each of them as a single line to standard output. "
+			"Compilation results of unchanged contracts are kept between the inputs."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -699,6 +853,13 @@ Allowed options)",
 			"and modify binaries in place."
 		)
 		(g_argMetadataLiteral.c_str(), "Store referenced sources are literal data in the metadata output.")
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Reuse the bytecode of contracts whose sources and settings did not change since a "
+			"previous compilation using the cache in the given directory. Also used in Standard JSON mode. "
+			"The cache is not used if assembly output or gas estimates are requested."
+		)
 		(
 			g_argAllowPaths.c_str(),
 			po::value<string>()->value_name("path(s)"),
@@ -850,10 +1011,15 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
+	if (m_args.count(g_strServer))
+		return serve(fileReader);
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
+		if (m_args.count(g_strCacheDir))
+			compiler.setCompilationCache(make_shared<CompilationCache>(m_args[g_strCacheDir].as<string>()));
 		sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
@@ -950,6 +1116,17 @@ bool CommandLineInterface::processInput()
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR));
 		m_compiler->enableEWasmGeneration(m_args.count(g_argEWasm));
+		m_compiler->enableYulOptimiserProfiling(m_args.count(g_argYulOptimizerProfile));
+		m_compiler->setWorkerThreads(m_args[g_strThreads].as<unsigned>());
+		smt::PortfolioSettings smtSettings;
+		smtSettings.race = m_args.count(g_strSMTRace);
+		if (m_args.count(g_strSMTTimeout))
+			smtSettings.queryTimeout = m_args[g_strSMTTimeout].as<unsigned>();
+		if (m_args.count(g_strSMTCacheDir))
+			smtSettings.cache = make_shared<smt::SMTQueryCache>(m_args[g_strSMTCacheDir].as<string>());
+		m_compiler->setSMTSolverSettings(smtSettings);
+		if (m_args.count(g_strCacheDir) && !assemblyRequested())
+			m_compiler->setCacheDirectory(m_args[g_strCacheDir].as<string>());
 
 		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
@@ -1176,7 +1353,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_strServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1281,14 +1458,15 @@ bool CommandLineInterface::assemble(
 )
 {
 	bool successful = true;
+	OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+	settings.workerThreads = max(m_args[g_strThreads].as<unsigned>(), 1u);
 	map<string, yul::AssemblyStack> assemblyStacks;
+	map<string, shared_ptr<yul::OptimiserProfile>> profiles;
 	for (auto const& src: m_sourceCodes)
 	{
-		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(
-			m_evmVersion,
-			_language,
-			_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
-		);
+		if (m_args.count(g_argYulOptimizerProfile))
+			settings.yulOptimiserProfile = profiles[src.first] = make_shared<yul::OptimiserProfile>();
+		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -1383,6 +1561,12 @@ bool CommandLineInterface::assemble(
 			sout() << object.assembly << endl;
 		else
 			serr() << "No text representation found." << endl;
+
+		if (profiles.count(src.first))
+		{
+			sout() << endl;
+			handleYulOptimizerProfile(profiles.at(src.first)->toJson());
+		}
 	}
 
 	return true;
@@ -1424,6 +1608,8 @@ void CommandLineInterface::outputCompilationResults()
 
 		if (m_args.count(g_argGas))
 			handleGasEstimation(contract);
+		if (m_args.count(g_argYulOptimizerProfile))
+			handleYulOptimizerProfile(m_compiler->yulOptimiserProfile(contract));
 
 		handleBytecode(contract);
 		handleIR(contract);
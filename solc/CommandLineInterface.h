@@ -59,6 +59,9 @@ private:
 
 	bool assemble(yul::AssemblyStack::Language _language, yul::AssemblyStack::Machine _targetMachine, bool _optimize);
 
+	/// Compiles Standard JSON inputs read line by line from the standard input until it is closed.
+	bool serve(dev::solidity::ReadCallback::Callback const& _fileReader);
+
 	void outputCompilationResults();
 
 	void handleCombinedJSON();
@@ -73,8 +76,14 @@ private:
 	void handleABI(std::string const& _contract);
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
+	/// Prints the time spent in the steps of the Yul optimiser, see yul::OptimiserProfile::toJson.
+	void handleYulOptimizerProfile(Json::Value const& _profile);
 	void handleFormal();
 
+	/// @returns true if any requested output needs the assembly of the contracts,
+	/// which is not available for contracts restored from the compilation cache.
+	bool assemblyRequested() const;
+
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
 	/// Tries to read from the file @a _input or interprets _input literally if that fails.
@@ -428,6 +428,18 @@ SOLTMPDIR=$(mktemp -d)
     fi
 )
 
+printTask "Testing server mode..."
+(
+    set -e
+    input='{"language": "Solidity", "sources": {"a.sol": {"content": "contract C {}"}}, "settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}}'
+    output=$(printf '%s\n\n%s\n' "$input" "$input" | "$SOLC" --server)
+    if [[ $(echo "$output" | wc -l) != 2 || $(echo "$output" | grep -c '"object"') != 2 ]]
+    then
+        printError "Incorrect output in server mode: $output"
+        exit 1
+    fi
+)
+
 printTask "Testing soljson via the fuzzer..."
 SOLTMPDIR=$(mktemp -d)
 (
@@ -0,0 +1,147 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the parallel execution helpers.
+ */
+
+#include <libdevcore/Parallel.h>
+
+#include <test/Options.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(Parallel)
+
+BOOST_AUTO_TEST_CASE(runs_every_task_once)
+{
+	for (unsigned threads: {0u, 1u, 3u, 16u})
+	{
+		vector<atomic<unsigned>> calls(100);
+		parallelFor(calls.size(), threads, [&](size_t _index) { ++calls[_index]; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_smallest_index)
+{
+	for (unsigned threads: {1u, 4u})
+	{
+		vector<atomic<bool>> started(50);
+		try
+		{
+			parallelFor(started.size(), threads, [&](size_t _index) {
+				started[_index] = true;
+				if (_index == 17 || _index == 30)
+					throw runtime_error(to_string(_index));
+			});
+			BOOST_FAIL("Expected an exception.");
+		}
+		catch (runtime_error const& _error)
+		{
+			BOOST_CHECK_EQUAL(string(_error.what()), "17");
+		}
+		for (size_t i = 0; i <= 17; ++i)
+			BOOST_CHECK(started[i]);
+		if (threads == 1)
+			BOOST_CHECK(!started[18]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_runs_added_tasks)
+{
+	for (unsigned threads: {1u, 4u})
+	{
+		vector<atomic<unsigned>> calls(100);
+		vector<future<void>> results;
+		{
+			ThreadPool pool(threads);
+			for (size_t i = 0; i < calls.size(); ++i)
+				results.emplace_back(pool.addTask([&, i]() {
+					++calls[i];
+					if (i == 42)
+						throw runtime_error("42");
+				}));
+			for (size_t i = 0; i < results.size(); ++i)
+				if (i == 42)
+					BOOST_CHECK_THROW(results[i].get(), runtime_error);
+				else
+					results[i].get();
+		}
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls_share_the_pool)
+{
+	mutex threadsMutex;
+	set<thread::id> threads;
+	vector<atomic<unsigned>> calls(8 * 8 * 8);
+	parallelFor(8, 8, [&](size_t _outer)
+	{
+		parallelFor(8, 8, [&](size_t _middle)
+		{
+			parallelFor(8, 8, [&](size_t _inner)
+			{
+				++calls[(_outer * 8 + _middle) * 8 + _inner];
+				lock_guard<mutex> lock(threadsMutex);
+				threads.insert(this_thread::get_id());
+			});
+		});
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count, 1);
+	// The calling thread and the threads of the shared pool, no matter how deeply nested.
+	BOOST_CHECK_LE(threads.size(), ThreadPool::shared().threads() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_finishes_queued_tasks)
+{
+	vector<atomic<unsigned>> calls(100);
+	vector<future<void>> results;
+	{
+		ThreadPool pool(2);
+		for (size_t i = 0; i < calls.size(); ++i)
+			results.emplace_back(pool.addTask([&, i]() {
+				this_thread::sleep_for(chrono::microseconds(100));
+				++calls[i];
+			}));
+	}
+	for (auto& result: results)
+		result.get();
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
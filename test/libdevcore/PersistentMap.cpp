@@ -0,0 +1,164 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the persistent map.
+ */
+
+#include <libdevcore/PersistentMap.h>
+
+#include <test/Options.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+template <class Key, class Value>
+map<Key, Value> toMap(PersistentMap<Key, Value> const& _map)
+{
+	map<Key, Value> result;
+	for (auto const& entry: _map)
+		BOOST_REQUIRE(result.insert(entry).second);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PersistentMapTest)
+
+BOOST_AUTO_TEST_CASE(basic_operations)
+{
+	PersistentMap<int, int> m;
+	BOOST_CHECK(m.empty());
+	m.set(2, 20);
+	m.set(1, 10);
+	m.set(3, 30);
+	m.set(2, 21);
+	BOOST_CHECK(!m.empty());
+	BOOST_CHECK_EQUAL(m.count(2), 1);
+	BOOST_CHECK_EQUAL(m.at(2), 21);
+	BOOST_CHECK(!m.find(4));
+	BOOST_CHECK_THROW(m.at(4), out_of_range);
+	BOOST_CHECK(m.erase(1));
+	BOOST_CHECK(!m.erase(1));
+	BOOST_CHECK((toMap(m) == map<int, int>{{2, 21}, {3, 30}}));
+	m.eraseAbove(2);
+	BOOST_CHECK((toMap(m) == map<int, int>{{2, 21}}));
+	m.clear();
+	BOOST_CHECK(m.empty());
+	BOOST_CHECK(m.begin() == m.end());
+}
+
+BOOST_AUTO_TEST_CASE(copies_are_independent)
+{
+	PersistentMap<int, int> original;
+	for (int i = 0; i < 100; ++i)
+		original.set(i, i);
+	PersistentMap<int, int> copy = original;
+	BOOST_CHECK(copy == original);
+	copy.set(50, -1);
+	copy.erase(10);
+	copy.eraseAbove(80);
+	original.set(90, -2);
+	BOOST_CHECK(copy != original);
+	for (int i = 0; i < 100; ++i)
+	{
+		BOOST_CHECK_EQUAL(original.at(i), i == 90 ? -2 : i);
+		if (i == 10 || i > 80)
+			BOOST_CHECK(!copy.find(i));
+		else
+			BOOST_CHECK_EQUAL(copy.at(i), i == 50 ? -1 : i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(equality_does_not_depend_on_history)
+{
+	PersistentMap<vector<unsigned>, int> a;
+	PersistentMap<vector<unsigned>, int> b;
+	for (unsigned i = 0; i < 50; ++i)
+	{
+		a.set({i, i + 1}, int(i));
+		b.set({49 - i, 50 - i}, int(49 - i));
+	}
+	b.set({100}, 1);
+	BOOST_CHECK(a != b);
+	b.erase({100});
+	BOOST_CHECK(a == b);
+	b.set({3, 4}, 7);
+	BOOST_CHECK(a != b);
+}
+
+BOOST_AUTO_TEST_CASE(random_operations)
+{
+	// Compares a map, its copies and their intersections to std::map.
+	mt19937 generator(1);
+	uniform_int_distribution<int> key(0, 200);
+	uniform_int_distribution<int> operation(0, 99);
+	PersistentMap<int, int> m;
+	map<int, int> reference;
+	vector<pair<PersistentMap<int, int>, map<int, int>>> copies;
+	for (int i = 0; i < 20000; ++i)
+	{
+		int k = key(generator);
+		int op = operation(generator);
+		if (op < 60)
+		{
+			m.set(k, k % 7);
+			reference[k] = k % 7;
+		}
+		else if (op < 90)
+			BOOST_REQUIRE_EQUAL(m.erase(k), reference.erase(k) == 1);
+		else if (op < 92)
+		{
+			m.eraseAbove(k);
+			reference.erase(reference.upper_bound(k), reference.end());
+		}
+		else if (op < 97 || copies.empty())
+			copies.emplace_back(m, reference);
+		else
+		{
+			auto const& copy = copies[size_t(k) % copies.size()];
+			m.intersect(copy.first);
+			for (auto it = reference.begin(); it != reference.end();)
+				if (copy.second.count(it->first) && copy.second.at(it->first) == it->second)
+					++it;
+				else
+					it = reference.erase(it);
+		}
+		BOOST_REQUIRE_EQUAL(m.count(k), reference.count(k));
+	}
+	BOOST_REQUIRE(toMap(m) == reference);
+	for (auto const& copy: copies)
+	{
+		BOOST_REQUIRE(toMap(copy.first) == copy.second);
+		BOOST_CHECK_EQUAL(copy.first == m, copy.second == reference);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
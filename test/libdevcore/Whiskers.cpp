@@ -194,6 +194,29 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(incomplete_constructs_rendered)
+{
+	string templ = "<?b>X<#l>Y</b <!b> </l <a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A").render(), "<?b>X<#l>Y</b <!b> </l A");
+}
+
+BOOST_AUTO_TEST_CASE(condition_inside_list)
+{
+	string templ = "<#l><?c><x><!c>-</c></l>";
+	vector<Whiskers::StringMap> list(2);
+	list[0]["x"] = "1";
+	list[1]["x"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("l", list).render(), "12");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("l", list).render(), "--");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_rendered_repeatedly)
+{
+	string templ = "<a><?c>C<!c>D</c>";
+	for (size_t i = 0; i < 3; ++i)
+		BOOST_CHECK_EQUAL(Whiskers(templ)("a", to_string(i))("c", i % 2 == 0).render(), to_string(i) + (i % 2 == 0 ? "C" : "D"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -148,6 +148,28 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(tag_push_sizes)
+{
+	Assembly _assembly;
+	auto near = _assembly.newTag();
+	auto far = _assembly.newTag();
+	_assembly.append(near);
+	_assembly.appendJump(near);
+	_assembly.appendJump(far);
+	for (size_t i = 0; i < 300; ++i)
+		_assembly.append(Instruction::STOP);
+	_assembly.append(far);
+	_assembly.appendJump(near);
+
+	checkCompilation(_assembly);
+
+	// Only the tag behind the first 256 bytes needs two bytes.
+	string code = _assembly.assemble().toHex();
+	BOOST_CHECK_EQUAL(code.substr(0, 16), "5b60005661013456");
+	BOOST_CHECK_EQUAL(code.substr(16, 600), string(600, '0'));
+	BOOST_CHECK_EQUAL(code.substr(616), "5b600056");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -27,6 +27,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -834,6 +835,59 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_mutual_recursion)
+{
+	// Two pairs of blocks that jump to each other. All four blocks are equivalent.
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMPI,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(5),
+		u256(6),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(5),
+		u256(6),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		u256(5),
+		u256(6),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 4),
+		u256(5),
+		u256(6),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 5),
+		u256(5),
+		u256(7),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMP
+	};
+	BlockDeduplicator dedup(input);
+	BOOST_CHECK(dedup.deduplicate());
+
+	set<u256> pushTags;
+	for (AssemblyItem const& item: input)
+		if (item.type() == PushTag)
+			pushTags.insert(item.data());
+	BOOST_CHECK(pushTags == set<u256>({1, 5}));
+	map<u256, u256> expectedReplacements{{2, 1}, {3, 1}, {4, 1}};
+	BOOST_CHECK(dedup.replacedTags() == expectedReplacements);
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1158,6 +1212,60 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(subassemblies_optimised_concurrently)
+{
+	// Sub-assemblies are optimised concurrently, also if some of them share a nested
+	// sub-assembly. The result has to be the same as with a single thread.
+	auto createSub = [](u256 const& _value) {
+		AssemblyPointer sub = make_shared<Assembly>();
+		sub->append(_value);
+		auto t1 = sub->newTag();
+		sub->append(t1);
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		auto t2 = sub->newTag();
+		sub->append(t2); // Identical to t1, will be unified
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		sub->append(u256(3));
+		sub->append(u256(4));
+		sub->append(Instruction::ADD);
+		sub->append(t2.pushTag());
+		sub->append(Instruction::JUMP);
+		return make_pair(sub, t2);
+	};
+	auto createMain = [&]() {
+		auto main = make_shared<Assembly>();
+		auto shared = createSub(u256(100)).first;
+		for (unsigned i = 0; i < 6; ++i)
+		{
+			auto sub = createSub(u256(i));
+			if (i % 3 == 0)
+				sub.first->appendSubroutine(shared);
+			size_t subId = size_t(main->appendSubroutine(sub.first).data());
+			main->append(sub.second.toSubAssemblyTag(subId));
+		}
+		return main;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = dev::test::Options::get().evmVersion();
+
+	auto serial = createMain();
+	serial->optimise(settings);
+	settings.threads = 4;
+	auto concurrent = createMain();
+	concurrent->optimise(settings);
+
+	BOOST_CHECK_EQUAL(serial->assemblyString(), concurrent->assemblyString());
+	BOOST_CHECK_EQUAL(serial->assemble().toHex(), concurrent->assemble().toHex());
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1370,6 +1478,34 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache)
+{
+	u256 const mask = (u256(1) << 160) - 1;
+	auto optimise = [&](EVMVersion _evmVersion) {
+		Assembly assembly;
+		assembly.append(mask);
+		assembly.append(mask);
+		ConstantOptimisationMethod::optimiseConstants(false, 1, _evmVersion, assembly);
+		return assembly.items();
+	};
+
+	ComputeMethod::clearCache();
+	AssemblyItems computed = optimise(EVMVersion::constantinople());
+	BOOST_CHECK(computed != (AssemblyItems{mask, mask}));
+	BOOST_CHECK_EQUAL(ComputeMethod::cacheHits(), 0);
+	// The cached representation is used for the second assembly.
+	BOOST_CHECK(optimise(EVMVersion::constantinople()) == computed);
+	size_t hits = ComputeMethod::cacheHits();
+	BOOST_CHECK(hits > 0);
+	// The cache distinguishes EVM versions, the older one does not have shifts.
+	AssemblyItems withoutShifts = optimise(EVMVersion::homestead());
+	BOOST_CHECK(count(withoutShifts.begin(), withoutShifts.end(), AssemblyItem(Instruction::SHL)) == 0);
+	BOOST_CHECK_EQUAL(ComputeMethod::cacheHits(), hits);
+	ComputeMethod::clearCache();
+	BOOST_CHECK(optimise(EVMVersion::constantinople()) == computed);
+	BOOST_CHECK_EQUAL(ComputeMethod::cacheHits(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
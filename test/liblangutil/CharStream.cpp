@@ -47,6 +47,26 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(translate_positions)
+{
+	CharStream const source("first\n\nthird line\nlast", "source");
+
+	BOOST_CHECK(source.translatePositionToLineColumn(0) == std::make_tuple(0, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(5) == std::make_tuple(0, 5));
+	BOOST_CHECK(source.translatePositionToLineColumn(6) == std::make_tuple(1, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(7) == std::make_tuple(2, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(12) == std::make_tuple(2, 5));
+	BOOST_CHECK(source.translatePositionToLineColumn(22) == std::make_tuple(3, 4));
+	BOOST_CHECK(source.translatePositionToLineColumn(1000) == std::make_tuple(3, 4));
+
+	// A position pointing to a newline belongs to the line ending there.
+	BOOST_CHECK_EQUAL(source.lineAtPosition(5), "first");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(6), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(10), "third line");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(1000), "last");
+	BOOST_CHECK_EQUAL(CharStream("", "empty").lineAtPosition(0), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -359,6 +359,52 @@ BOOST_AUTO_TEST_CASE(complex_control_flow)
 	testRunTimeGas("ln(int128)", vector<bytes>{encodeArgs(0), encodeArgs(10), encodeArgs(105), encodeArgs(30000)});
 }
 
+BOOST_AUTO_TEST_CASE(step_limit)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint x;
+			function f(uint a) public returns (uint) {
+				x = a * a + 7;
+				return x;
+			}
+		}
+	)";
+	compile(sourceCode);
+	AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	langutil::EVMVersion evmVersion = dev::test::Options::get().evmVersion();
+	BOOST_CHECK(!PathGasMeter(items, evmVersion).estimateMax(0, make_shared<KnownState>()).isInfinite);
+	// Giving up is signalled by an infinite estimate.
+	BOOST_CHECK(PathGasMeter(items, evmVersion, 10).estimateMax(0, make_shared<KnownState>()).isInfinite);
+}
+
+BOOST_AUTO_TEST_CASE(block_summaries)
+{
+	// Both branches reach tag 2 with the same state, so the block there is analysed once.
+	AssemblyItems items{
+		u256(0), Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1), Instruction::JUMPI,
+		AssemblyItem(PushTag, 2), Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2), Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(5), u256(0), Instruction::SSTORE,
+		u256(7), u256(0), Instruction::MSTORE,
+		Instruction::STOP
+	};
+	langutil::EVMVersion evmVersion = dev::test::Options::get().evmVersion();
+	PathGasMeter unmemoised(items, evmVersion, PathGasMeter::defaultStepLimit, false);
+	GasMeter::GasConsumption expected = unmemoised.estimateMax(0, make_shared<KnownState>());
+	BOOST_REQUIRE(!expected.isInfinite);
+
+	PathGasMeter memoised(items, evmVersion);
+	GasMeter::GasConsumption gas = memoised.estimateMax(0, make_shared<KnownState>());
+	BOOST_REQUIRE(!gas.isInfinite);
+	BOOST_CHECK_EQUAL(gas.value, expected.value);
+	// The six items after tag 2 count as one step when the summary is reused.
+	BOOST_CHECK_EQUAL(memoised.steps() + 5, unmemoised.steps());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
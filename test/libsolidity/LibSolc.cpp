@@ -20,6 +20,8 @@
  */
 
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libdevcore/JSON.h>
 #include <libsolidity/interface/Version.h>
@@ -170,6 +172,58 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: File not found."));
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_contexts)
+{
+	auto input = [](unsigned _index)
+	{
+		string source =
+			"contract C" + to_string(_index) + " {"
+			"  mapping(uint => uint) m;"
+			"  function f(uint a) public returns (uint) { m[a] = a * " + to_string(_index + 2) + "; return m[a] + 1; }"
+			"  function g(string memory s) public pure returns (bytes32) { return keccak256(bytes(s)); }"
+			"}";
+		Json::Value input{Json::objectValue};
+		input["language"] = "Solidity";
+		input["sources"]["a.sol"]["content"] = source;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+		input["settings"]["outputSelection"]["*"]["*"][1] = "evm.methodIdentifiers";
+		return jsonCompactPrint(input);
+	};
+
+	size_t const threads = 4;
+	vector<string> expectations;
+	for (unsigned i = 0; i < threads; ++i)
+	{
+		expectations.emplace_back(solidity_compile(input(i).c_str(), nullptr));
+		BOOST_REQUIRE(expectations.back().find("\"object\"") != string::npos);
+	}
+
+	vector<vector<string>> outputs(threads);
+	vector<thread> workers;
+	for (unsigned i = 0; i < threads; ++i)
+		workers.emplace_back([&, i]()
+		{
+			solidity_context* context = solidity_context_create();
+			for (unsigned repetition = 0; repetition < 3; ++repetition)
+			{
+				string output = solidity_context_compile(context, input(i).c_str(), nullptr);
+				if (output != solidity_context_output(context))
+					output.clear();
+				outputs[i].emplace_back(move(output));
+			}
+			solidity_context_destroy(context);
+		});
+	for (thread& worker: workers)
+		worker.join();
+
+	for (unsigned i = 0; i < threads; ++i)
+		for (string const& output: outputs[i])
+			BOOST_CHECK_EQUAL(output, expectations[i]);
+	solidity_free();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -20,9 +20,17 @@
 
 #include <test/libsolidity/AnalysisFramework.h>
 
+#include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTPortfolio.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#ifdef HAVE_Z3
+#include <libsolidity/formal/Z3Interface.h>
+#endif
+
 #include <boost/test/unit_test.hpp>
 
 #include <string>
+#include <thread>
 
 using namespace std;
 using namespace langutil;
@@ -248,6 +256,96 @@ BOOST_AUTO_TEST_CASE(mod)
 	CHECK_SUCCESS_NO_WARNINGS(text);
 }
 
+BOOST_AUTO_TEST_CASE(portfolio_settings)
+{
+	// The SMT-LIB2 interface keeps a reference to the responses.
+	map<h256, string> responses;
+	for (bool race: {false, true})
+	{
+		smt::PortfolioSettings settings;
+		settings.race = race;
+		settings.queryTimeout = 60000;
+		smt::SMTPortfolio portfolio(responses, settings);
+		// Without an integrated solver, there is nobody to answer the queries.
+		if (portfolio.solvers() == 1)
+			return;
+
+		smt::Expression x = portfolio.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+		portfolio.addAssertion(x > size_t(1));
+		portfolio.push();
+		portfolio.addAssertion(x < size_t(1));
+		BOOST_CHECK(portfolio.check({}).first == smt::CheckResult::UNSATISFIABLE);
+		portfolio.pop();
+		portfolio.addAssertion(x < size_t(3));
+		auto result = portfolio.check({x});
+		BOOST_CHECK(result.first == smt::CheckResult::SATISFIABLE);
+		BOOST_REQUIRE_EQUAL(result.second.size(), 1);
+		BOOST_CHECK_EQUAL(result.second.front(), "2");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(portfolio_query_cache)
+{
+	map<h256, string> responses;
+	auto cache = make_shared<smt::SMTQueryCache>();
+	smt::PortfolioSettings settings;
+	settings.cache = cache;
+	auto setUp = [](smt::SolverInterface& _solver, string const& _name)
+	{
+		smt::Expression x = _solver.newVariable(_name, make_shared<smt::Sort>(smt::Kind::Int));
+		_solver.addAssertion(x > size_t(1));
+		return x;
+	};
+
+	// The names only differ in the AST IDs, so the normalised queries are the same.
+	smt::SMTLib2Interface reference(responses);
+	smt::Expression referenceX = setUp(reference, "x_7_0");
+	smt::SMTPortfolio portfolio(responses, settings);
+	smt::Expression x = setUp(portfolio, "x_42_0");
+
+	// Answers in the cache are used without asking the solvers.
+	cache->store(
+		smt::SMTQueryCache::key(portfolio.identity(), reference.normalisedQuery({})),
+		{smt::CheckResult::UNSATISFIABLE, {}}
+	);
+	BOOST_CHECK(portfolio.check({}).first == smt::CheckResult::UNSATISFIABLE);
+
+	// Other queries are passed on to the solvers and their answers are stored.
+	BOOST_CHECK(portfolio.check({x}).first != smt::CheckResult::UNSATISFIABLE);
+	auto cached = cache->load(smt::SMTQueryCache::key(portfolio.identity(), reference.normalisedQuery({referenceX})));
+	BOOST_CHECK_EQUAL(bool(cached), portfolio.solvers() > 1);
+	if (cached)
+		BOOST_CHECK(cached->first == smt::CheckResult::SATISFIABLE);
+}
+
+#ifdef HAVE_Z3
+BOOST_AUTO_TEST_CASE(z3_interrupt_at_end_of_query)
+{
+	smt::Z3Interface solver;
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	solver.addAssertion(x > size_t(1));
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		// The delays vary, so that some of the interruptions arrive while Z3 returns
+		// from the query, after it stopped checking for them.
+		thread interrupter([&]()
+		{
+			for (size_t j = 0; j < i % 50; ++j)
+				this_thread::yield();
+			solver.interrupt();
+		});
+		solver.check({});
+		interrupter.join();
+		solver.clearInterrupt();
+
+		solver.push();
+		solver.addAssertion(x < size_t(1));
+		BOOST_REQUIRE(solver.check({}).first == smt::CheckResult::UNSATISFIABLE);
+		solver.pop();
+	}
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
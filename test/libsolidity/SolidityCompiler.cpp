@@ -22,6 +22,12 @@
 #include <test/Metadata.h>
 #include <test/Options.h>
 
+#include <libsolidity/ast/ASTJsonConverter.h>
+
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+
 using namespace std;
 
 namespace dev
@@ -31,6 +37,25 @@ namespace solidity
 namespace test
 {
 
+namespace
+{
+
+void collectIDs(Json::Value const& _node, vector<int>& o_ids)
+{
+	if (_node.isObject())
+	{
+		if (_node.isMember("id"))
+			o_ids.push_back(_node["id"].asInt());
+		if (_node.isMember("foreign") && _node["foreign"].isInt())
+			o_ids.push_back(_node["foreign"].asInt());
+	}
+	if (_node.isObject() || _node.isArray())
+		for (auto const& child: _node)
+			collectIDs(child, o_ids);
+}
+
+}
+
 BOOST_FIXTURE_TEST_SUITE(SolidityCompiler, AnalysisFramework)
 
 BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
@@ -53,6 +78,185 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_compilation_is_deterministic)
+{
+	char const* sourceCode = R"(
+		contract A { function f() public pure returns (uint) { return 1; } }
+		contract B { function f() public returns (A) { return new A(); } }
+		contract C { function f() public returns (A) { return new A(); } }
+		contract D { uint x; function f(uint y) public { x = y * 7; } }
+		contract E { function f() public returns (D) { return new D(); } }
+		contract F { function f(uint a, uint b) public pure returns (uint) { return a ** b; } }
+	)";
+	map<string, bytes> serialObjects;
+	for (unsigned threads: {1u, 4u})
+	{
+		compiler().reset();
+		compiler().setOptimiserSettings(dev::test::Options::get().optimize);
+		compiler().setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler().setWorkerThreads(threads);
+		compiler().setSources({{"", string(sourceCode)}});
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contracts failed");
+		for (string const& name: compiler().contractNames())
+			if (threads == 1)
+				serialObjects[name] = compiler().object(name).bytecode;
+			else
+				BOOST_CHECK(compiler().object(name).bytecode == serialObjects.at(name));
+	}
+	BOOST_CHECK_EQUAL(serialObjects.size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_is_deterministic)
+{
+	StringMap sources{
+		{"a.sol", "import \"b.sol\"; import {L as M} from \"c.sol\"; contract A is B { function g() public { M.f(); } }"},
+		{"b.sol", "import \"c.sol\"; contract B { function f() public pure returns (uint) { return 7; } }"},
+		{"c.sol", "library L { function f() internal pure {} } contract C { uint[] x; }"},
+		{"d.sol", "contract D { event E(uint indexed a); function f() public { emit E(2); assembly { let x := 1 } } }"}
+	};
+	string serialAST;
+	for (unsigned threads: {1u, 4u})
+	{
+		compiler().reset();
+		compiler().setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler().setWorkerThreads(threads);
+		compiler().setSources(sources);
+		BOOST_REQUIRE_MESSAGE(compiler().parseAndAnalyze(), "Analysing sources failed");
+
+		Json::Value ast{Json::objectValue};
+		for (string const& name: compiler().sourceNames())
+			ast[name] = ASTJsonConverter(false, compiler().sourceIndices()).toJson(compiler().ast(name));
+		vector<int> ids;
+		collectIDs(ast, ids);
+		sort(ids.begin(), ids.end());
+		BOOST_CHECK(adjacent_find(ids.begin(), ids.end()) == ids.end());
+
+		if (threads == 1)
+			serialAST = jsonCompactPrint(ast);
+		else
+			BOOST_CHECK_EQUAL(jsonCompactPrint(ast), serialAST);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_keeps_error_limit)
+{
+	// Each source stays below the error limit, but together they exceed it.
+	string faultyContracts;
+	for (size_t i = 0; i < 150; ++i)
+		faultyContracts += "contract C" + to_string(i) + " { function f() public { uint x = ; } }\n";
+	StringMap sources{
+		{"a.sol", "import \"b.sol\";\n" + faultyContracts},
+		{"b.sol", faultyContracts},
+		{"c.sol", "contract D { function f() public { uint x = ; } }"}
+	};
+	vector<pair<langutil::Error::Type, string>> serialErrors;
+	for (unsigned threads: {1u, 4u})
+	{
+		compiler().reset();
+		compiler().setParserErrorRecovery(true);
+		compiler().setWorkerThreads(threads);
+		compiler().setSources(sources);
+		BOOST_CHECK(!compiler().parse());
+
+		vector<pair<langutil::Error::Type, string>> errors;
+		for (auto const& error: compiler().errors())
+		{
+			string const* message = boost::get_error_info<errinfo_comment>(*error);
+			errors.emplace_back(error->type(), message ? *message : "");
+		}
+		BOOST_REQUIRE(!errors.empty());
+		BOOST_CHECK_EQUAL(errors.back().second, "There are more than 256 errors. Aborting.");
+
+		if (threads == 1)
+			serialErrors = move(errors);
+		else
+			BOOST_CHECK(errors == serialErrors);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	char const* sourceCode = R"(
+		contract A { function f() public pure returns (uint) { return 1; } }
+		contract B { function f() public returns (A) { return new A(); } }
+	)";
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	map<string, bytes> objects;
+	map<string, string> sourceMappings;
+	for (bool cached: {false, true})
+	{
+		compiler().reset();
+		compiler().setOptimiserSettings(dev::test::Options::get().optimize);
+		compiler().setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler().setCacheDirectory(cacheDirectory.string());
+		compiler().setSources({{"", string(sourceCode)}});
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contracts failed");
+		for (string const& name: compiler().contractNames())
+		{
+			BOOST_REQUIRE(compiler().sourceMapping(name));
+			if (!cached)
+			{
+				BOOST_CHECK(compiler().assemblyItems(name));
+				objects[name] = compiler().object(name).bytecode;
+				sourceMappings[name] = *compiler().sourceMapping(name);
+			}
+			else
+			{
+				// Restored from the cache, i.e. not compiled again.
+				BOOST_CHECK(!compiler().assemblyItems(name));
+				BOOST_CHECK(compiler().object(name).bytecode == objects.at(name));
+				BOOST_CHECK_EQUAL(*compiler().sourceMapping(name), sourceMappings.at(name));
+			}
+		}
+	}
+	compiler().reset();
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_dependencies_and_settings)
+{
+	char const* sourceCode = R"(
+		contract A { function f() public pure returns (uint) { return 1; } }
+		contract B { function f() public returns (A) { return new A(); } }
+	)";
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	auto compile = [&](string const& _contract, bool _optimize)
+	{
+		compiler().reset();
+		compiler().setOptimiserSettings(_optimize);
+		compiler().setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler().setCacheDirectory(cacheDirectory.string());
+		compiler().setSources({{"", string(sourceCode)}});
+		compiler().setRequestedContractNames({{"", {_contract}}});
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contracts failed");
+	};
+
+	// A is only compiled as a dependency of B, but stored as well.
+	compile("B", false);
+	bytes objectA = compiler().object("A").bytecode;
+	compile("A", false);
+	BOOST_CHECK(!compiler().assemblyItems("A"));
+	BOOST_CHECK(compiler().object("A").bytecode == objectA);
+
+	// B depends on the restored A and gets the same bytecode as before.
+	compile("B", false);
+	BOOST_CHECK(!compiler().assemblyItems("B"));
+	bytes objectB = compiler().object("B").bytecode;
+	boost::filesystem::remove_all(cacheDirectory);
+	compile("B", false);
+	BOOST_CHECK(compiler().assemblyItems("B"));
+	BOOST_CHECK(compiler().object("B").bytecode == objectB);
+
+	// Settings that change the bytecode are part of the key.
+	compile("B", true);
+	BOOST_CHECK(compiler().assemblyItems("B"));
+
+	compiler().reset();
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -1071,6 +1071,58 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(yul_optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "yulOptimizerProfile" ], "B": [ "*" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "yul": true } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental ABIEncoderV2; contract A { function f(uint[] memory x) public pure returns (bytes memory) { return abi.encode(x); } } contract B { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value profile = getContractResult(result, "fileA", "A")["yulOptimizerProfile"];
+	BOOST_REQUIRE(profile.isObject());
+	BOOST_CHECK(profile["suiteRuns"].asUInt() > 0);
+	BOOST_CHECK(profile["rounds"].asUInt() > 0);
+	BOOST_REQUIRE(profile["steps"].isArray());
+	BOOST_REQUIRE(profile["steps"].size() > 0);
+	BOOST_CHECK_EQUAL(profile["steps"][0]["stage"].asString(), "preparation");
+	vector<string> stages{"preparation", "round", "finalisation"};
+	auto sortKey = [&](Json::Value const& _step) {
+		auto stage = find(stages.begin(), stages.end(), _step["stage"].asString());
+		BOOST_REQUIRE(stage != stages.end());
+		return make_tuple(stage - stages.begin(), _step["round"].asUInt(), _step["index"].asUInt(), _step["name"].asString());
+	};
+	// The steps are sorted by their position in the sequence.
+	for (Json::ArrayIndex i = 1; i < profile["steps"].size(); ++i)
+		BOOST_CHECK(sortKey(profile["steps"][i - 1]) < sortKey(profile["steps"][i]));
+	Json::Value const& step = profile["steps"][0];
+	BOOST_CHECK_EQUAL(step["index"].asUInt(), 0);
+	BOOST_CHECK_EQUAL(step["name"].asString(), "Disambiguator");
+	BOOST_CHECK_EQUAL(step["runs"].asUInt(), profile["suiteRuns"].asUInt());
+	BOOST_CHECK(step["changedRuns"].asUInt() <= step["runs"].asUInt());
+	BOOST_CHECK(step["sizeDelta"].isInt64());
+	// Steps that occur several times in the sequence are reported separately.
+	size_t blockFlatteners = 0;
+	for (Json::Value const& entry: profile["steps"])
+		if (entry["stage"].asString() == "preparation" && entry["name"].asString() == "BlockFlattener")
+			blockFlatteners++;
+	BOOST_CHECK_EQUAL(blockFlatteners, 3);
+	// The wildcard does not request the profile.
+	BOOST_CHECK(!getContractResult(result, "fileA", "B").isMember("yulOptimizerProfile"));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for sharing generated Yul functions between contracts.
+ */
+
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulFunctionCacheTest)
+
+BOOST_AUTO_TEST_CASE(dependencies_are_shared)
+{
+	auto cache = make_shared<YulFunctionCache>();
+	size_t creations = 0;
+	auto createOuter = [&](MultiUseYulFunctionCollector& _collector) {
+		return _collector.createFunction("outer", [&]() {
+			++creations;
+			string inner = _collector.createFunction("inner", [&]() {
+				++creations;
+				return string("function inner() {}\n");
+			});
+			return "function outer() { " + inner + "() }\n";
+		});
+	};
+
+	MultiUseYulFunctionCollector first(cache);
+	createOuter(first);
+	string code = first.requestedFunctions();
+	BOOST_CHECK_EQUAL(creations, 2);
+
+	MultiUseYulFunctionCollector second(cache);
+	createOuter(second);
+	BOOST_CHECK_EQUAL(creations, 2);
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), code);
+
+	// Also after the functions of a collector were retrieved.
+	createOuter(second);
+	BOOST_CHECK_EQUAL(creations, 2);
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), code);
+}
+
+BOOST_AUTO_TEST_CASE(contract_specific_functions_are_not_shared)
+{
+	auto cache = make_shared<YulFunctionCache>();
+	MultiUseYulFunctionCollector first(cache);
+	first.createContractSpecificFunction("f", []() { return string("function f() { a() }\n"); });
+	MultiUseYulFunctionCollector second(cache);
+	second.createContractSpecificFunction("f", []() { return string("function f() { b() }\n"); });
+	BOOST_CHECK_EQUAL(first.requestedFunctions(), "function f() { a() }\n");
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), "function f() { b() }\n");
+	BOOST_CHECK(!cache->find("f"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -14,9 +14,9 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 1122600
-//   executionCost: 1167
-//   totalCost: 1123767
+//   codeDepositCost: 1119800
+//   executionCost: 1160
+//   totalCost: 1120960
 // external:
 //   a(): 530
 //   b(uint256): infinite
@@ -13,8 +13,8 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 256800
-//   executionCost: 300
-//   totalCost: 257100
+//   codeDepositCost: 255600
+//   executionCost: 294
+//   totalCost: 255894
 // external:
 //   f(): 252
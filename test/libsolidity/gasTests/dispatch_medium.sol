@@ -11,9 +11,9 @@ contract Medium {
 }
 // ----
 // creation:
-//   codeDepositCost: 253000
+//   codeDepositCost: 251000
 //   executionCost: 294
-//   totalCost: 253294
+//   totalCost: 251294
 // external:
 //   a(): 428
 //   b(uint256): 846
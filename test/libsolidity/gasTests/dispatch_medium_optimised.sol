@@ -14,9 +14,9 @@ contract Medium {
 // optimize-runs: 2
 // ----
 // creation:
-//   codeDepositCost: 140800
+//   codeDepositCost: 136800
 //   executionCost: 183
-//   totalCost: 140983
+//   totalCost: 136983
 // external:
 //   a(): 398
 //   b(uint256): 863
@@ -6,9 +6,9 @@ contract Small {
 }
 // ----
 // creation:
-//   codeDepositCost: 83600
-//   executionCost: 135
-//   totalCost: 83735
+//   codeDepositCost: 80800
+//   executionCost: 129
+//   totalCost: 80929
 // external:
 //   fallback: 118
 //   a(): 383
@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the allocation of Yul AST nodes.
+ */
+
+#include <libyul/AsmData.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+#include <test/Options.h>
+
+#include <libdevcore/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulNodeArena)
+
+BOOST_AUTO_TEST_CASE(nodes_are_aligned)
+{
+	vector<NodePtr<Expression>> nodes;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		nodes.emplace_back(makeNode<Expression>(Identifier{{}, YulString{"x" + to_string(i)}}));
+		BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(nodes.back().get()) % alignof(max_align_t), 0);
+	}
+	for (size_t i = 0; i < nodes.size(); ++i)
+		BOOST_CHECK_EQUAL(boost::get<Identifier>(*nodes[i]).name.str(), "x" + to_string(i));
+	// Larger than a chunk.
+	struct Large { char data[100000]; };
+	NodePtr<Large> large = makeNode<Large>();
+	large->data[99999] = 1;
+}
+
+BOOST_AUTO_TEST_CASE(nodes_destroyed_on_other_threads)
+{
+	size_t const tasks = 8;
+	vector<vector<NodePtr<Expression>>> nodes(tasks);
+	dev::parallelFor(tasks, tasks, [&](size_t _task)
+	{
+		for (size_t i = 0; i < 5000; ++i)
+			nodes[_task].emplace_back(makeNode<Expression>(Literal{{}, LiteralKind::Number, YulString{to_string(i)}, {}}));
+	});
+	for (auto const& taskNodes: nodes)
+	{
+		BOOST_REQUIRE_EQUAL(taskNodes.size(), 5000);
+		BOOST_CHECK_EQUAL(boost::get<Literal>(*taskNodes.back()).value.str(), "4999");
+	}
+	// Every task destroys the nodes created by another one.
+	dev::parallelFor(tasks, tasks, [&](size_t _task)
+	{
+		nodes[(_task + 1) % tasks].clear();
+	});
+}
+
+BOOST_AUTO_TEST_CASE(optimised_ast_does_not_retain_temporaries)
+{
+	string source = "{\n";
+	for (size_t i = 0; i < 40; ++i)
+	{
+		string f = "f" + to_string(i);
+		source +=
+			"function " + f + "(a, b) -> r {\n"
+			"  r := add(mul(a, " + to_string(i + 2) + "), div(b, add(a, 1)))\n"
+			"  if gt(r, 100) { r := sub(r, a) }\n"
+			"  for { let j := 0 } lt(j, a) { j := add(j, 1) } { r := add(r, " + f + "(j, r)) }\n"
+			"}\n"
+			"sstore(" + to_string(i) + ", " + f + "(sload(" + to_string(i) + "), calldataload(" + to_string(i) + ")))\n";
+	}
+	source += "}\n";
+
+	AsmNodeArena::startNewChunk();
+	size_t before = AsmNodeArena::allocatedBytes();
+	AssemblyStack stack(
+		dev::test::Options::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		dev::solidity::OptimiserSettings::full()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", source));
+	stack.optimize();
+	size_t retained = AsmNodeArena::allocatedBytes() - before;
+
+	// The optimised AST should take about as much memory as a fresh copy of it.
+	AsmNodeArena::startNewChunk();
+	before = AsmNodeArena::allocatedBytes();
+	Block copy = boost::get<Block>(ASTCopier{}(*stack.parserResult()->code));
+	size_t compact = AsmNodeArena::allocatedBytes() - before;
+	BOOST_CHECK_GT(compact, 0);
+	BOOST_CHECK_LE(retained, compact + 2 * 16 * 1024);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
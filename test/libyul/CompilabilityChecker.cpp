@@ -156,7 +156,7 @@ BOOST_AUTO_TEST_CASE(multiple_functions)
 			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
 		}
 	})");
-	BOOST_CHECK_EQUAL(out, "h: 9 g: 5 f: 5 ");
+	BOOST_CHECK_EQUAL(out, "g: 5 f: 5 h: 9 ");
 }
 
 BOOST_AUTO_TEST_CASE(nested)
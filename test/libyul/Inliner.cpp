@@ -90,7 +90,7 @@ BOOST_AUTO_TEST_CASE(simple_inside_structures)
 		"{"
 			"function h() -> y:u256 { y := 2:u256 }"
 		"}"
-	"}"), "h,g,f");
+	"}"), "g,f,h");
 }
 
 BOOST_AUTO_TEST_CASE(negative)
@@ -325,6 +325,21 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		obj.code = m_ast;
 		obj.analysisInfo = m_analysisInfo;
 		OptimiserSuite::run(*m_dialect, &meter, obj, true);
+
+		// Optimising functions concurrently has to produce the same code.
+		AssemblyStack stack(
+			dev::test::Options::get().evmVersion(),
+			m_yul ? AssemblyStack::Language::Yul : AssemblyStack::Language::StrictAssembly,
+			dev::solidity::OptimiserSettings::none()
+		);
+		soltestAssert(stack.parseAndAnalyze("", m_source), "");
+		yul::Object parallelObject = *stack.parserResult();
+		OptimiserSuite::run(*m_dialect, &meter, parallelObject, true, {}, 4);
+		if (AsmPrinter{m_yul}(*parallelObject.code) != AsmPrinter{m_yul}(*m_ast))
+		{
+			AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Result differs when using several threads." << endl;
+			return TestResult::FatalError;
+		}
 	}
 	else
 	{
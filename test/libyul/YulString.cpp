@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libdevcore/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStrings)
+
+BOOST_AUTO_TEST_CASE(equal_strings_are_equal)
+{
+	YulString a("abc");
+	YulString b(string("ab") + "c");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(!(a < b) && !(b < a));
+	BOOST_CHECK(a != YulString("abd"));
+	BOOST_CHECK_EQUAL(b.str(), "abc");
+	BOOST_CHECK(YulString().empty());
+	BOOST_CHECK(YulString("").empty());
+}
+
+BOOST_AUTO_TEST_CASE(hash_is_platform_independent)
+{
+	// The order of YulStrings depends on the hash, so it must not change between platforms.
+	BOOST_CHECK_EQUAL(YulStringRepository::hash(""), YulStringRepository::emptyHash());
+	BOOST_CHECK_EQUAL(YulStringRepository::hash("a"), 0x0d1fe023b446f5bdu);
+	BOOST_CHECK_EQUAL(YulStringRepository::hash("abc"), 0xace851eda0b65b8fu);
+	BOOST_CHECK_EQUAL(YulStringRepository::hash("Nobody inspects the spammish repetition"), 0x08b9f44bfd20a84bu);
+	BOOST_CHECK_EQUAL(YulStringRepository::hash("0123456789abcdef0123456789abcdef0123456789"), 0xb90a0a4aec549ea3u);
+	BOOST_CHECK_EQUAL(YulString("abc").hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	// More strings than fit into a single chunk, interned by several threads at once.
+	size_t const count = 10000;
+	size_t const tasks = 8;
+	vector<vector<YulString>> strings(tasks);
+	dev::parallelFor(tasks, tasks, [&](size_t _task)
+	{
+		for (size_t i = 0; i < count; ++i)
+			strings[_task].emplace_back("concurrent_" + to_string((i + _task * 997) % count));
+	});
+
+	for (size_t task = 0; task < tasks; ++task)
+		for (size_t i = 0; i < count; ++i)
+		{
+			size_t value = (i + task * 997) % count;
+			BOOST_REQUIRE_EQUAL(strings[task][i].str(), "concurrent_" + to_string(value));
+			BOOST_REQUIRE(strings[task][i] == strings[0][value]);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(reset_waits_for_users)
+{
+	auto use = make_unique<YulStringRepository::ScopedUse>();
+	BOOST_CHECK(!YulStringRepository::resetIfUnused());
+	atomic<bool> reset{false};
+	thread resetter([&]() {
+		YulStringRepository::reset();
+		reset = true;
+	});
+	this_thread::sleep_for(chrono::milliseconds(20));
+	BOOST_CHECK(!reset);
+	use.reset();
+	resetter.join();
+	BOOST_CHECK(reset);
+	BOOST_CHECK(YulStringRepository::resetIfUnused());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
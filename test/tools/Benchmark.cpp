@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Command line handling and time measurement shared by the benchmarks in this directory.
+ */
+
+#include <test/tools/Benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace dev::test;
+
+namespace po = boost::program_options;
+
+BenchmarkOptions::BenchmarkOptions(string const& _description, bool _inputFiles):
+	m_inputFiles(_inputFiles),
+	m_options(
+		_description + "\n\nAllowed options",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	)
+{
+	if (m_inputFiles)
+		m_options.add_options()
+			(
+				"input-file",
+				po::value<vector<string>>(),
+				"input file"
+			);
+	m_options.add_options()
+		(
+			"repetitions",
+			po::value<unsigned>()->default_value(20),
+			"Number of times every measurement is repeated."
+		);
+}
+
+boost::optional<int> BenchmarkOptions::parse(int _argc, char** _argv)
+{
+	m_options.add_options()("help", "Show this help screen.");
+
+	// All positional options should be interpreted as input files
+	po::positional_options_description filesPositions;
+	if (m_inputFiles)
+		filesPositions.add("input-file", -1);
+
+	try
+	{
+		po::command_line_parser cmdLineParser(_argc, _argv);
+		cmdLineParser.options(m_options).positional(filesPositions);
+		po::store(cmdLineParser.run(), m_arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (m_arguments.count("help") || (m_inputFiles && !m_arguments.count("input-file")))
+	{
+		cout << m_options;
+		return 0;
+	}
+	return boost::none;
+}
+
+unsigned BenchmarkOptions::repetitions() const
+{
+	return max(m_arguments["repetitions"].as<unsigned>(), 1u);
+}
+
+vector<string> BenchmarkOptions::inputFiles() const
+{
+	if (!m_arguments.count("input-file"))
+		return {};
+	return m_arguments["input-file"].as<vector<string>>();
+}
+
+void dev::test::measure(
+	string const& _name,
+	unsigned _repetitions,
+	function<void()> const& _prepare,
+	function<void()> const& _task,
+	size_t _units,
+	string const& _unit
+)
+{
+	chrono::nanoseconds total{0};
+	for (unsigned i = 0; i < _repetitions; ++i)
+	{
+		if (_prepare)
+			_prepare();
+		auto start = chrono::steady_clock::now();
+		_task();
+		total += chrono::steady_clock::now() - start;
+	}
+	double perRepetition = double(total.count()) / max(_repetitions, 1u);
+	cout << "  " << left << setw(36) << _name << right << fixed;
+	if (_unit.empty())
+		cout << setprecision(1) << setw(12) << perRepetition / 1000 << " us" << endl;
+	else
+		cout << setprecision(2) << setw(10) << perRepetition / max<size_t>(_units, 1) << " ns/" << _unit << endl;
+}
@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Command line handling and time measurement shared by the benchmarks in this directory.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace test
+{
+
+/**
+ * Command line options of a benchmark. Besides the options added by the benchmark, there
+ * are "repetitions", "help" and, if requested, input files as positional arguments.
+ */
+class BenchmarkOptions
+{
+public:
+	/// @param _description is shown by --help, followed by the list of options.
+	/// @param _inputFiles whether the benchmark needs at least one input file.
+	BenchmarkOptions(std::string const& _description, bool _inputFiles);
+
+	/// Adds options that are specific to the benchmark.
+	boost::program_options::options_description_easy_init add() { return m_options.add_options(); }
+
+	/// Parses the command line.
+	/// @returns the exit code if the benchmark should not run, e.g. because help was requested.
+	boost::optional<int> parse(int _argc, char** _argv);
+
+	boost::program_options::variables_map const& arguments() const { return m_arguments; }
+	/// @returns the number of times every measurement is repeated, at least one.
+	unsigned repetitions() const;
+	std::vector<std::string> inputFiles() const;
+
+private:
+	bool m_inputFiles;
+	boost::program_options::options_description m_options;
+	boost::program_options::variables_map m_arguments;
+};
+
+/// Runs @a _task @a _repetitions times and prints the average time of a repetition under
+/// @a _name. @a _prepare, if set, is run before every repetition and not measured.
+/// If @a _unit is given, every repetition processes @a _units items of that kind and the
+/// time per item is printed in nanoseconds instead of the time per repetition in microseconds.
+void measure(
+	std::string const& _name,
+	unsigned _repetitions,
+	std::function<void()> const& _prepare,
+	std::function<void()> const& _task,
+	size_t _units = 0,
+	std::string const& _unit = {}
+);
+
+}
+}
@@ -0,0 +1,127 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for the constant optimiser.
+ */
+
+#include <test/tools/Benchmark.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::solidity;
+using namespace dev::test;
+using namespace langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Items of a creation or runtime assembly of one of the contracts.
+struct AssemblyCode
+{
+	AssemblyItems items;
+	bool isCreation;
+};
+
+/// Runs the constant optimiser on a fresh copy of every assembly.
+/// @returns the number of replaced constants.
+unsigned optimiseAll(vector<AssemblyCode> const& _code, size_t _runs, EVMVersion _evmVersion)
+{
+	unsigned optimisations = 0;
+	for (AssemblyCode const& code: _code)
+	{
+		Assembly assembly;
+		assembly.items() = code.items;
+		optimisations += ConstantOptimisationMethod::optimiseConstants(code.isCreation, _runs, _evmVersion, assembly);
+	}
+	return optimisations;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options(
+		R"(constantoptbench, benchmark for the constant optimiser.
+Usage: constantoptbench [Options] <file>...
+Compiles the given Solidity files without optimiser and measures how long it
+takes to optimise the constants of all creation and runtime assemblies, once
+with an empty cache of constant representations and once with a filled one.)",
+		true
+	);
+	options.add()
+		(
+			"runs",
+			po::value<size_t>()->default_value(200),
+			"The number of runs the constants are optimised for."
+		);
+	if (auto exitCode = options.parse(argc, argv))
+		return *exitCode;
+
+	map<string, string> sources;
+	for (string const& file: options.inputFiles())
+		sources[file] = readFileAsString(file);
+	unsigned repetitions = options.repetitions();
+	size_t runs = options.arguments()["runs"].as<size_t>();
+
+	CompilerStack compiler;
+	compiler.setSources(sources);
+	if (!compiler.compile())
+	{
+		SourceReferenceFormatter formatter(cerr);
+		for (auto const& error: compiler.errors())
+			formatter.printExceptionInformation(*error, error->type() == Error::Type::Warning ? "Warning" : "Error");
+		return 1;
+	}
+
+	vector<AssemblyCode> code;
+	for (string const& contract: compiler.contractNames())
+	{
+		if (AssemblyItems const* items = compiler.assemblyItems(contract))
+			code.push_back({*items, true});
+		if (AssemblyItems const* items = compiler.runtimeAssemblyItems(contract))
+			code.push_back({*items, false});
+	}
+
+	EVMVersion evmVersion;
+	ComputeMethod::clearCache();
+	unsigned optimisations = optimiseAll(code, runs, evmVersion);
+	cout << code.size() << " assemblies, " << optimisations << " constants replaced" << endl;
+
+	measure("empty cache", repetitions, []() { ComputeMethod::clearCache(); }, [&]() {
+		optimiseAll(code, runs, evmVersion);
+	});
+	measure("filled cache", repetitions, nullptr, [&]() {
+		optimiseAll(code, runs, evmVersion);
+	});
+	return 0;
+}
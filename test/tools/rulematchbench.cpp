@@ -0,0 +1,306 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Micro-benchmark for matching expressions against the simplification rules of
+ * libevmasm and libyul, comparing the rule index to trying all rules in turn.
+ */
+
+#include <test/tools/Benchmark.h>
+
+#include <libevmasm/ExpressionClasses.h>
+#include <libevmasm/RuleList.h>
+#include <libevmasm/SimplificationRules.h>
+
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+
+#include <libdevcore/CommonData.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// The way the rules were matched before the rule index was introduced: all rules
+/// for the instruction of the expression are tried in turn.
+template <class Pattern, class Expression>
+class LinearMatcher: public boost::noncopyable
+{
+public:
+	/// @param _constant pattern that matches any constant.
+	/// @param _any pattern that matches anything.
+	LinearMatcher(Pattern const& _constant, Pattern const& _any)
+	{
+		Pattern A = _constant;
+		Pattern B = _constant;
+		Pattern C = _constant;
+		Pattern X = _any;
+		Pattern Y = _any;
+		A.setMatchGroup(1, m_matchGroups);
+		B.setMatchGroup(2, m_matchGroups);
+		C.setMatchGroup(3, m_matchGroups);
+		X.setMatchGroup(4, m_matchGroups);
+		Y.setMatchGroup(5, m_matchGroups);
+		for (auto const& rule: simplificationRuleList(A, B, C, X, Y))
+			m_rules[uint8_t(rule.pattern.instruction())].push_back(rule);
+	}
+
+	template <class... Context>
+	SimplificationRule<Pattern> const* findFirstMatch(
+		Instruction _instruction,
+		Expression const& _expr,
+		Context const&... _context
+	)
+	{
+		for (auto const& rule: m_rules[uint8_t(_instruction)])
+		{
+			m_matchGroups.clear();
+			if (rule.pattern.matches(_expr, _context...))
+				if (!rule.feasible || rule.feasible())
+					return &rule;
+		}
+		return nullptr;
+	}
+
+private:
+	std::map<unsigned, Expression const*> m_matchGroups;
+	std::vector<SimplificationRule<Pattern>> m_rules[256];
+};
+
+/// Generates random expressions that contain many opportunities for simplification.
+class ExpressionGenerator
+{
+public:
+	explicit ExpressionGenerator(unsigned _seed): m_random(_seed) {}
+
+	/// Builds an expression of at most @a _depth levels using the given functions.
+	template <class Node>
+	Node generate(
+		unsigned _depth,
+		function<Node(Instruction, vector<Node>)> const& _operation,
+		function<Node(u256 const&)> const& _constant,
+		function<Node(unsigned)> const& _variable
+	)
+	{
+		unsigned choice = uniform_int_distribution<unsigned>(0, 9)(m_random);
+		if (_depth == 0 || choice < 2)
+			return _constant(m_constants[uniform_int_distribution<size_t>(0, m_constants.size() - 1)(m_random)]);
+		else if (choice < 4)
+			return _variable(uniform_int_distribution<unsigned>(0, 2)(m_random));
+
+		Instruction instruction = m_instructions[uniform_int_distribution<size_t>(0, m_instructions.size() - 1)(m_random)];
+		vector<Node> arguments;
+		for (int i = 0; i < instructionInfo(instruction).args; ++i)
+			arguments.emplace_back(generate(_depth - 1, _operation, _constant, _variable));
+		return _operation(instruction, std::move(arguments));
+	}
+
+private:
+	mt19937 m_random;
+	vector<Instruction> const m_instructions{
+		Instruction::ADD, Instruction::MUL, Instruction::SUB, Instruction::DIV, Instruction::SDIV,
+		Instruction::MOD, Instruction::SMOD, Instruction::EXP, Instruction::NOT, Instruction::LT,
+		Instruction::GT, Instruction::SLT, Instruction::SGT, Instruction::EQ, Instruction::ISZERO,
+		Instruction::AND, Instruction::OR, Instruction::XOR, Instruction::BYTE, Instruction::SHL,
+		Instruction::SHR, Instruction::SAR, Instruction::ADDMOD, Instruction::MULMOD,
+		Instruction::SIGNEXTEND, Instruction::CALLDATALOAD, Instruction::MLOAD, Instruction::ADDRESS
+	};
+	vector<u256> const m_constants{0, 1, 2, 31, 32, 0xff, 0xffffffff, u256(1) << 160, u256(1) << 255, ~u256(0)};
+};
+
+/// @returns false if the matchers did not agree.
+bool benchmarkEVMAssembly(unsigned _expressions, unsigned _depth, unsigned _repetitions, unsigned _seed)
+{
+	ExpressionGenerator generator(_seed);
+	ExpressionClasses classes;
+	vector<ExpressionClasses::Id> variables;
+	for (unsigned i = 0; i < 3; ++i)
+		variables.push_back(classes.newClass(langutil::SourceLocation{}));
+	// ExpressionClasses already applies the rules when an expression is added, so the queries
+	// are the operations before that, referring to the classes of their arguments.
+	deque<AssemblyItem> items;
+	deque<ExpressionClasses::Expression> expressions;
+	for (unsigned i = 0; i < _expressions; ++i)
+		generator.generate<ExpressionClasses::Id>(
+			_depth,
+			[&](Instruction _instruction, vector<ExpressionClasses::Id> _arguments) {
+				items.emplace_back(_instruction);
+				ExpressionClasses::Id id = classes.find(items.back(), _arguments);
+				expressions.push_back(ExpressionClasses::Expression{id, &items.back(), move(_arguments)});
+				return id;
+			},
+			[&](u256 const& _value) { return classes.find(AssemblyItem(_value)); },
+			[&](unsigned _index) { return variables[_index]; }
+		);
+
+	vector<ExpressionClasses::Expression const*> queries;
+	for (auto const& expression: expressions)
+		queries.push_back(&expression);
+	cout << "libevmasm: " << queries.size() << " expressions" << endl;
+
+	LinearMatcher<Pattern, ExpressionClasses::Expression> linear{Pattern(Push), Pattern()};
+	Rules indexed;
+	size_t linearMatches = 0;
+	size_t indexedMatches = 0;
+	measure("linear", _repetitions, nullptr, [&]() {
+		for (auto const* expression: queries)
+			linearMatches += !!linear.findFirstMatch(expression->item->instruction(), *expression, classes);
+	}, queries.size(), "expression");
+	measure("rule index", _repetitions, nullptr, [&]() {
+		for (auto const* expression: queries)
+			indexedMatches += !!indexed.findFirstMatch(*expression, classes);
+	}, queries.size(), "expression");
+
+	for (auto const* expression: queries)
+	{
+		auto const* expected = linear.findFirstMatch(expression->item->instruction(), *expression, classes);
+		auto const* actual = indexed.findFirstMatch(*expression, classes);
+		if (!!expected != !!actual || (expected && expected->pattern.toString() != actual->pattern.toString()))
+		{
+			cerr << "Matchers disagree on " << classes.fullDAGToString(expression->id) << endl;
+			return false;
+		}
+	}
+	cout << "  " << indexedMatches / _repetitions << " expressions match a rule" << endl;
+	return linearMatches == indexedMatches;
+}
+
+void collectOperations(yul::Expression const& _expression, vector<yul::Expression const*>& o_operations)
+{
+	if (_expression.type() != typeid(yul::FunctionalInstruction))
+		return;
+	o_operations.push_back(&_expression);
+	for (auto const& argument: boost::get<yul::FunctionalInstruction>(_expression).arguments)
+		collectOperations(argument, o_operations);
+}
+
+/// @returns false if the matchers did not agree.
+bool benchmarkYul(unsigned _expressions, unsigned _depth, unsigned _repetitions, unsigned _seed)
+{
+	ExpressionGenerator generator(_seed);
+	vector<yul::Expression> expressions;
+	for (unsigned i = 0; i < _expressions; ++i)
+		expressions.emplace_back(generator.generate<yul::Expression>(
+			_depth,
+			[](Instruction _instruction, vector<yul::Expression> _arguments) -> yul::Expression {
+				return yul::FunctionalInstruction{{}, _instruction, std::move(_arguments)};
+			},
+			[](u256 const& _value) -> yul::Expression {
+				return yul::Literal{{}, yul::LiteralKind::Number, yul::YulString{formatNumber(_value)}, {}};
+			},
+			[](unsigned _index) -> yul::Expression {
+				return yul::Identifier{{}, yul::YulString{"x" + to_string(_index)}};
+			}
+		));
+
+	vector<yul::Expression const*> queries;
+	for (auto const& expression: expressions)
+		collectOperations(expression, queries);
+	cout << "libyul: " << queries.size() << " expressions" << endl;
+
+	yul::Dialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(langutil::EVMVersion{});
+	map<yul::YulString, yul::Expression const*> ssaValues;
+	LinearMatcher<yul::Pattern, yul::Expression> linear{yul::Pattern(yul::PatternKind::Constant), yul::Pattern()};
+	auto instructionOf = [](yul::Expression const* _expression) {
+		return boost::get<yul::FunctionalInstruction>(*_expression).instruction;
+	};
+	size_t linearMatches = 0;
+	size_t indexedMatches = 0;
+	measure("linear", _repetitions, nullptr, [&]() {
+		for (auto const* expression: queries)
+			linearMatches += !!linear.findFirstMatch(instructionOf(expression), *expression, dialect, ssaValues);
+	}, queries.size(), "expression");
+	measure("rule index", _repetitions, nullptr, [&]() {
+		for (auto const* expression: queries)
+			indexedMatches += !!yul::SimplificationRules::findFirstMatch(*expression, dialect, ssaValues);
+	}, queries.size(), "expression");
+
+	for (auto const* expression: queries)
+	{
+		auto const* expected = linear.findFirstMatch(instructionOf(expression), *expression, dialect, ssaValues);
+		auto const* actual = yul::SimplificationRules::findFirstMatch(*expression, dialect, ssaValues);
+		if (!!expected != !!actual || (expected && expected->removesNonConstants != actual->removesNonConstants))
+		{
+			cerr << "Matchers disagree." << endl;
+			return false;
+		}
+	}
+	cout << "  " << indexedMatches / _repetitions << " expressions match a rule" << endl;
+	return linearMatches == indexedMatches;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options(
+		R"(rulematchbench, benchmark for matching the simplification rules.
+Usage: rulematchbench [Options]
+Generates random expressions and measures how fast the simplification rules
+of libevmasm and libyul are matched against them, using the rule index and
+trying all rules in turn.)",
+		false
+	);
+	options.add()
+		(
+			"expressions",
+			po::value<unsigned>()->default_value(2000),
+			"Number of random expressions to generate."
+		)
+		(
+			"depth",
+			po::value<unsigned>()->default_value(4),
+			"Maximum nesting depth of the expressions."
+		)
+		(
+			"seed",
+			po::value<unsigned>()->default_value(1),
+			"Seed for generating the expressions."
+		);
+	if (auto exitCode = options.parse(argc, argv))
+		return *exitCode;
+
+	po::variables_map const& arguments = options.arguments();
+	unsigned expressions = arguments["expressions"].as<unsigned>();
+	unsigned depth = arguments["depth"].as<unsigned>();
+	unsigned repetitions = options.repetitions();
+	unsigned seed = arguments["seed"].as<unsigned>();
+
+	bool agree = benchmarkEVMAssembly(expressions, depth, repetitions, seed);
+	agree = benchmarkYul(expressions, depth, repetitions, seed) && agree;
+	if (!agree)
+	{
+		cerr << "The matchers did not find the same rules." << endl;
+		return 1;
+	}
+	return 0;
+}
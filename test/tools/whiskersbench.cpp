@@ -0,0 +1,139 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for rendering the Whiskers templates of the ABI coder.
+ */
+
+#include <test/tools/Benchmark.h>
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Whiskers.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::test;
+using namespace langutil;
+
+namespace
+{
+
+/// Parameter and return types of an external function.
+struct Signature
+{
+	TypePointers parameters;
+	TypePointers returnParameters;
+};
+
+/// Generates the ABI encoders and decoders of all @a _signatures.
+/// @returns the number of characters of the generated code.
+size_t generateCoders(EVMVersion _evmVersion, vector<Signature> const& _signatures)
+{
+	ABIFunctions abiFunctions(_evmVersion);
+	for (Signature const& signature: _signatures)
+	{
+		abiFunctions.tupleDecoder(signature.parameters);
+		abiFunctions.tupleDecoder(signature.parameters, true);
+		abiFunctions.tupleEncoder(signature.returnParameters, signature.returnParameters);
+		abiFunctions.tupleEncoderPacked(signature.parameters, signature.parameters);
+	}
+	return abiFunctions.requestedFunctions().first.size();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options(
+		R"(whiskersbench, benchmark for Whiskers templates.
+Usage: whiskersbench [Options] <file>...
+Compiles the given Solidity files up to analysis and measures how long it
+takes to generate the ABI encoders and decoders of all external functions,
+which is dominated by rendering Whiskers templates.)",
+		true
+	);
+	if (auto exitCode = options.parse(argc, argv))
+		return *exitCode;
+
+	map<string, string> sources;
+	for (string const& file: options.inputFiles())
+		sources[file] = readFileAsString(file);
+	unsigned repetitions = options.repetitions();
+
+	CompilerStack compiler;
+	compiler.setSources(sources);
+	if (!compiler.parseAndAnalyze())
+	{
+		SourceReferenceFormatter formatter(cerr);
+		for (auto const& error: compiler.errors())
+			formatter.printExceptionInformation(*error, error->type() == Error::Type::Warning ? "Warning" : "Error");
+		return 1;
+	}
+
+	vector<Signature> signatures;
+	for (string const& sourceName: compiler.sourceNames())
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(compiler.ast(sourceName).nodes()))
+			for (auto const& function: contract->interfaceFunctionList())
+				signatures.push_back({function.second->parameterTypes(), function.second->returnParameterTypes()});
+
+	EVMVersion evmVersion;
+	size_t codeSize = generateCoders(evmVersion, signatures);
+	cout << signatures.size() << " external functions, " << codeSize << " characters of ABI coder code" << endl;
+
+	measure("ABI coder generation", repetitions, nullptr, [&]() {
+		generateCoders(evmVersion, signatures);
+	});
+	string const templ = R"(
+		function <functionName>(headStart, dataEnd) -> <valueReturnParams> {
+			if slt(sub(dataEnd, headStart), <minimumSize>) { <revertString> }
+			<#decodeElements>
+				{
+					let offset := <offset>
+					<values> := <abiDecode>(add(headStart, offset), dataEnd)
+				}
+			</decodeElements>
+			<?fromMemory>mload(0)<!fromMemory>calldataload(0)</fromMemory>
+		}
+	)";
+	vector<Whiskers::StringMap> elements(4, {{"offset", "32"}, {"values", "value0"}, {"abiDecode", "abi_decode_t_uint256"}});
+	measure("single template, 1000 renderings", repetitions, nullptr, [&]() {
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			Whiskers whiskers(templ);
+			whiskers
+				("functionName", "abi_decode_tuple_t_uint256")
+				("valueReturnParams", "value0")
+				("minimumSize", "32")
+				("revertString", "revert(0, 0)")
+				("decodeElements", elements)
+				("fromMemory", i % 2 == 0);
+			whiskers.render();
+		}
+	});
+	return 0;
+}
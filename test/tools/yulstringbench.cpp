@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Micro-benchmark for hashing and interning Yul identifiers.
+ */
+
+#include <test/tools/Benchmark.h>
+
+#include <libyul/YulString.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Parallel.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::test;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// @returns all identifiers of the Yul code @a _source in the order in which they appear.
+vector<string> identifiers(string const& _source)
+{
+	auto isStart = [](char _c) { return isalpha(static_cast<unsigned char>(_c)) || _c == '_' || _c == '$'; };
+	auto isPart = [&](char _c) { return isStart(_c) || isdigit(static_cast<unsigned char>(_c)) || _c == '.'; };
+
+	vector<string> result;
+	for (size_t i = 0; i < _source.size();)
+		if (_source[i] == '"')
+		{
+			// Skip string literals.
+			for (++i; i < _source.size() && _source[i] != '"'; ++i)
+				if (_source[i] == '\\')
+					++i;
+			++i;
+		}
+		else if (_source.compare(i, 2, "//") == 0)
+			i = min(_source.find('\n', i), _source.size());
+		else if (_source.compare(i, 2, "/*") == 0)
+			i = min(_source.find("*/", i), _source.size()) + 2;
+		else if (isdigit(static_cast<unsigned char>(_source[i])))
+			while (i < _source.size() && isalnum(static_cast<unsigned char>(_source[i])))
+				++i;
+		else if (isStart(_source[i]))
+		{
+			size_t start = i;
+			while (i < _source.size() && isPart(_source[i]))
+				++i;
+			result.emplace_back(_source.substr(start, i - start));
+		}
+		else
+			++i;
+	return result;
+}
+
+/// The hash function that was used for Yul strings before, for comparison.
+uint64_t fnvHash(string const& _string)
+{
+	uint64_t hash = 14695981039346656037u;
+	for (auto c: _string)
+	{
+		hash *= 1099511628211u;
+		hash ^= c;
+	}
+	return hash;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options(
+		R"(yulstringbench, benchmark for Yul string interning.
+Usage: yulstringbench [Options] <file>...
+Reads the identifiers from the given Yul files (for example the output
+of solc --ir or --ir-optimized) and measures how fast they are hashed
+and interned as YulStrings.)",
+		true
+	);
+	options.add()
+		(
+			"threads",
+			po::value<unsigned>()->default_value(4),
+			"Number of threads used for concurrent interning."
+		);
+	if (auto exitCode = options.parse(argc, argv))
+		return *exitCode;
+
+	vector<string> stream;
+	for (string const& file: options.inputFiles())
+	{
+		vector<string> fileIdentifiers = identifiers(readFileAsString(file));
+		stream.insert(stream.end(), fileIdentifiers.begin(), fileIdentifiers.end());
+	}
+	size_t characters = 0;
+	for (string const& identifier: stream)
+		characters += identifier.size();
+	unsigned repetitions = options.repetitions();
+	unsigned threads = max(options.arguments()["threads"].as<unsigned>(), 1u);
+
+	cout << stream.size() << " identifiers, " << characters << " characters" << endl;
+	if (stream.empty())
+		return 0;
+
+	auto reset = []() { YulStringRepository::reset(); };
+	// Accumulate the hashes so that the computation cannot be optimised away.
+	uint64_t checksum = 0;
+
+	cout << "Hashing:" << endl;
+	measure("FNV-1a (previous)", repetitions, nullptr, [&]() {
+		for (string const& identifier: stream)
+			checksum += fnvHash(identifier);
+	}, stream.size(), "identifier");
+	measure("YulStringRepository::hash", repetitions, nullptr, [&]() {
+		for (string const& identifier: stream)
+			checksum += YulStringRepository::hash(identifier);
+	}, stream.size(), "identifier");
+
+	cout << "Interning:" << endl;
+	measure("empty repository", repetitions, reset, [&]() {
+		for (string const& identifier: stream)
+			checksum += YulString(identifier).hash();
+	}, stream.size(), "identifier");
+	measure("strings already interned", repetitions, nullptr, [&]() {
+		for (string const& identifier: stream)
+			checksum += YulString(identifier).hash();
+	}, stream.size(), "identifier");
+	vector<uint64_t> checksums(threads);
+	measure("empty repository, " + to_string(threads) + " threads", repetitions, reset, [&]() {
+		parallelFor(threads, threads, [&](size_t _thread)
+		{
+			for (size_t i = _thread; i < stream.size(); i += threads)
+				checksums[_thread] += YulString(stream[i]).hash();
+		});
+	}, stream.size(), "identifier");
+	for (uint64_t value: checksums)
+		checksum += value;
+
+	cout << "Checksum: " << hex << checksum << endl;
+	return 0;
+}